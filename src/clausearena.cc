@@ -0,0 +1,130 @@
+//////////////////////////////////////////////////////////////
+//
+// Source File
+//
+// File name: clausearena.cc
+// Introduction:
+//    Contiguous clause store with 64-bit hash deduplication.
+//
+//////////////////////////////////////////////////////////////
+
+#include "clausearena.h"
+#include <cstring>
+#include <algorithm>
+
+/*------------------------------------------------------------------------------------
+ FuncName:
+    hashLits
+ Introduction:
+    64-bit FNV-1a over the literals, finished by the mixer of splitmix64
+ -------------------------------------------------------------------------------------*/
+uint64_t ClauseArena::hashLits( const int *lits, long size )
+{
+    uint64_t hash = 14695981039346656037ULL ;
+    for( long loop = 0; loop < size; loop++ )
+    {
+        hash ^= (uint32_t)lits[loop] ;
+        hash *= 1099511628211ULL ;
+    }
+    hash ^= hash >> 30 ; hash *= 0xbf58476d1ce4e5b9ULL ;
+    hash ^= hash >> 27 ; hash *= 0x94d049bb133111ebULL ;
+    hash ^= hash >> 31 ;
+    return hash ;
+}
+
+/*------------------------------------------------------------------------------------
+ FuncName:
+    findSlot
+ Introduction:
+    Slot of the table holding the clause, or the empty slot where it belongs
+    (linear probing; the literals are compared only if the hashes are equal)
+ -------------------------------------------------------------------------------------*/
+long ClauseArena::findSlot( const int *lits, long size, uint64_t hash ) const
+{
+    size_t mask = this->_table.size() - 1 ;
+    size_t slot = hash & mask ;
+    while( this->_table[slot] != 0 )
+    {
+        long idx = this->_table[slot] - 1 ;
+        if( this->_hash[idx] == hash && this->getClauseSize(idx) == size &&
+            memcmp( this->getLiterals(idx), lits, size * sizeof(int) ) == 0 )
+            break ;
+        slot = ( slot + 1 ) & mask ;
+    }
+    return (long)slot ;
+}
+
+void ClauseArena::rehash( size_t capacity )
+{
+    this->_table.assign( capacity, 0 );
+    for( long idx = 0; idx < this->size(); idx++ )
+    {
+        size_t slot = this->_hash[idx] & ( capacity - 1 );
+        while( this->_table[slot] != 0 ) slot = ( slot + 1 ) & ( capacity - 1 );
+        this->_table[slot] = idx + 1 ;
+    }
+}
+
+/*------------------------------------------------------------------------------------
+ FuncName:
+    insert, find, clear
+ Introduction:
+    insert appends the clause unless it exists (load factor <= 1/2)
+ -------------------------------------------------------------------------------------*/
+bool ClauseArena::insert( const int *lits, long size, long *idx )
+{
+    if( 2 * ( this->size() + 1 ) > (long)this->_table.size() )
+        this->rehash( max( (size_t)1024, this->_table.size() * 2 ) );
+    uint64_t hash = hashLits( lits, size );
+    long     slot = this->findSlot( lits, size, hash );
+    if( this->_table[slot] != 0 )
+    {
+        if( idx ) *idx = this->_table[slot] - 1 ;
+        return false ;
+    }
+    this->_table[slot] = this->size() + 1 ;
+    if( idx ) *idx = this->size() ;
+    this->_lits.insert( this->_lits.end(), lits, lits + size );
+    this->_start.push_back( (long)this->_lits.size() );
+    this->_hash.push_back( hash );
+    return true ;
+}
+
+long ClauseArena::find( const vector<int> &lits ) const
+{
+    if( this->_table.empty() ) return -1 ;
+    long slot = this->findSlot( lits.data(), (long)lits.size(), hashLits( lits.data(), (long)lits.size() ) );
+    return this->_table[slot] - 1 ;
+}
+
+void ClauseArena::clear( void )
+{
+    this->_lits.clear();
+    this->_start.assign( 1, 0 );
+    this->_hash.clear();
+    this->_table.clear();
+}
+
+size_t ClauseArena::getMemoryUsage( void ) const
+{
+    return this->_lits.capacity() * sizeof(int) + this->_start.capacity() * sizeof(long) +
+           this->_hash.capacity() * sizeof(uint64_t) + this->_table.capacity() * sizeof(long) ;
+}
+
+/*------------------------------------------------------------------------------------
+ FuncName:
+    toString
+ Introduction:
+    DIMACS line of a clause (literals separated by a space, ended by 0)
+ -------------------------------------------------------------------------------------*/
+string ClauseArena::toString( long idx ) const
+{
+    return toString( this->getClause(idx) );
+}
+
+string ClauseArena::toString( const vector<int> &lits )
+{
+    string line = "" ;
+    for( auto lit: lits ) line += to_string(lit) + " " ;
+    return line + "0" ;
+}
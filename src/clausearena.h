@@ -0,0 +1,69 @@
+//////////////////////////////////////////////////////////////
+//
+// Header File
+//
+// File name: clausearena.h
+// Introduction:
+//    Clause store: the literals (DIMACS, +v/-v) of all clauses
+//    in one contiguous int array, deduplicated by a 64-bit hash
+//    table. Clauses are turned into DIMACS text only when they
+//    are dumped (CNF file, clause log).
+//
+//////////////////////////////////////////////////////////////
+
+#ifndef CLAUSEARENA_H
+#define CLAUSEARENA_H
+
+#include <vector>
+#include <string>
+#include <cstdint>
+
+using namespace std;
+
+/*------------------------------------------------------------------
+ Data Type Name:
+    ClauseArena
+ Introduction:
+    Clause i is the literal run _lits[ _start[i], _start[i+1] ) (no
+    trailing 0). Indices are given in insertion order and never move,
+    so they can be kept by other containers (e.g. the timing clause DB).
+    Two clauses are the same if their literal runs are identical.
+ -------------------------------------------------------------------*/
+class ClauseArena
+{
+private:
+    vector< int >       _lits   ;//literal runs of all clauses
+    vector< long >      _start  ;//start of each clause in _lits (+ end of the last one)
+    vector< uint64_t >  _hash   ;//hash of each clause
+    vector< long >      _table  ;//open addressing: clause index + 1 (0: empty slot)
+
+    static uint64_t hashLits( const int *lits, long size );
+    long        findSlot( const int *lits, long size, uint64_t hash ) const;
+    void        rehash( size_t capacity );
+
+public:
+    //-Constructor--------------------------------------------------------------------
+    ClauseArena( void ) : _start(1, 0) {}
+
+    //-Setter methods-----------------------------------------------------------------
+    //Return true if the clause is new; its index is stored in "idx"
+    bool    insert( const int *lits, long size, long *idx = nullptr );
+    bool    insert( const vector<int> &lits, long *idx = nullptr )  { return insert( lits.data(), (long)lits.size(), idx ); }
+    void    clear( void );
+
+    //-Getter methods-----------------------------------------------------------------
+    long    find( const vector<int> &lits ) const;  //-1: not found
+    long    size( void ) const                  { return (long)_start.size() - 1        ; }
+    bool    empty( void ) const                 { return _start.size() == 1             ; }
+    long    getLiteralNumber( void ) const      { return (long)_lits.size()             ; }
+    long    getClauseSize( long idx ) const     { return _start[idx+1] - _start[idx]    ; }
+    const int*  getLiterals( long idx ) const   { return _lits.data() + _start[idx]     ; }
+    vector<int> getClause( long idx ) const     { return vector<int>( _lits.begin() + _start[idx], _lits.begin() + _start[idx+1] ); }
+    size_t  getMemoryUsage( void ) const ;      //bytes
+
+    //-Dumper-------------------------------------------------------------------------
+    string  toString( long idx ) const ;        //"1 -2 3 0"
+    static string toString( const vector<int> &lits );
+};
+
+#endif  // CLAUSEARENA_H
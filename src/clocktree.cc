@@ -16,6 +16,8 @@
 #include <fcntl.h>
 #include <sys/wait.h>
 #include <sys/stat.h>
+#include <thread>
+#include <signal.h>
 
 #define RED     "\x1b[31m"
 #define GREEN   "\x1b[32m"
@@ -26,6 +28,32 @@
 #define CYAN    "\x1b[36m"
 #define RESET   "\x1b[0m"
 
+//-- Buffer the timing clauses go to on a worker thread of buildTimingClauseDB
+//-- (nullptr: the timing clause DB of the clock tree) ---------------------------
+static thread_local TIMING_CLAUSE_BUF *TcClauseBuf = nullptr ;
+
+/*------------------------------------------------------------------
+ Data Type Name:
+    PORTFOLIO_CONFIG
+ Introduction:
+    Solver configurations raced by "-portfolio N" (the first N are
+    used). "_minisatopt" is the closest setting of ./minisat
+    ("-sat=minisat"), which has no option of the initial phase.
+ -------------------------------------------------------------------*/
+struct PORTFOLIO_CONFIG
+{
+    const char  *_name      ;
+    SAT_CONFIG   _config    ;
+    const char  *_minisatopt;
+};
+static const PORTFOLIO_CONFIG SatPortfolio[PORTFOLIO_MAX] =
+{
+    { "luby-neg",   { SAT_RESTART_LUBY, 100, 2,   0,        0,    SAT_PHASE_NEG  }, ""                                                      },
+    { "geom-pos",   { SAT_RESTART_GEOM, 100, 1.5, 91648253, 0,    SAT_PHASE_POS  }, "-no-luby -rinc=1.5 -rnd-init -rnd-seed=91648253"       },
+    { "luby-rand",  { SAT_RESTART_LUBY, 50,  2,   1234567,  0.02, SAT_PHASE_RAND }, "-rfirst=50 -rnd-freq=0.02 -rnd-init -rnd-seed=1234567" },
+    { "geom-neg",   { SAT_RESTART_GEOM, 200, 1.2, 7654321,  0.01, SAT_PHASE_NEG  }, "-no-luby -rfirst=200 -rinc=1.2 -rnd-freq=0.01 -rnd-seed=7654321" },
+};
+
 /////////////////////////////////////////////////////////////////////
 //
 // ClockTree Class - Private Method
@@ -184,64 +212,166 @@ void ClockTree::initTcBound(void)
 /////////////////////////////////////////////////////////////////////
 //
 // ClockTree Class - Private Method
-// Generate all DCC constraint clauses according to every combinations
+// Var "DCC (leader) on the node or on an upper node of the same clock
+// path" of an unmasked clock node (created once, with the var of the
+// nearest unmasked upper node first):
+//      DCC (leader) on node => var, var of upper node => var
 // Input parameter:
-// comblist: combinations (2 dimension array)
+// leader: false => DCC vars (var, var+1), true => header var (var+2)
+// upper: nearest unmasked upper node of each node (by node number, nullptr: none)
+// abovevar: vars created so far (by node number)
+// list/ctr: clause list of the constraint and its counter
 //
 /////////////////////////////////////////////////////////////////////
-void ClockTree::genDccConstraintClause( vector<vector<long> > *comblist )
+int ClockTree::genAboveVar( CTN *node, bool leader, map<long, CTN*> &upper, map<long, int> &abovevar, ClauseArena &list, long &ctr )
 {
-	for( long loop1 = 0; loop1 < comblist->size(); loop1++ )
-	{
-		if( comblist->at(loop1).size() == 2 )
-		{
-			// Generate 4 clauses based on two clock nodes
-			string clause1, clause2, clause3, clause4;
-			long nodenum1 = comblist->at(loop1).at(0), nodenum2 = comblist->at(loop1).at(1);
-            
-			clause1 = to_string((nodenum1 * -1)) + " " + to_string((nodenum2 * -1)) + " 0";
-			clause2 = to_string((nodenum1 * -1)) + " " + to_string(((nodenum2 + 1) * -1)) + " 0";
-			clause3 = to_string(((nodenum1 + 1) * -1)) + " " + to_string((nodenum2 * -1)) + " 0";
-			clause4 = to_string(((nodenum1 + 1) * -1)) + " " + to_string(((nodenum2 + 1) * -1)) + " 0";
-			if(this->_dccconstraintlist.size() < (this->_dccconstraintlist.max_size()-4))
-			{
-                if( _dccconstraintlist.find(clause1) == _dccconstraintlist.end() ) this->_dcc_constraint_ctr ++ ;
-                if( _dccconstraintlist.find(clause2) == _dccconstraintlist.end() ) this->_dcc_constraint_ctr ++ ;
-                if( _dccconstraintlist.find(clause3) == _dccconstraintlist.end() ) this->_dcc_constraint_ctr ++ ;
-                if( _dccconstraintlist.find(clause4) == _dccconstraintlist.end() ) this->_dcc_constraint_ctr ++ ;
-				this->_dccconstraintlist.insert(clause1);
-				this->_dccconstraintlist.insert(clause2);
-				this->_dccconstraintlist.insert(clause3);
-				this->_dccconstraintlist.insert(clause4);
-                
-                
-                if( _printClause )
-                {
-                    auto find = this->getDCCSet().find( pair<int,int>(comblist->at(loop1).at(0),comblist->at(loop1).at(1)) );
-                    if( find == this->getDCCSet().end() ){
-                        fprintf( fptr,"DCC (%ld with %ld): %s, %s, %s, %s \n", nodenum1, nodenum2, clause1.c_str(), clause2.c_str(), clause3.c_str(), clause4.c_str() );
-                        this->getDCCSet().insert(pair<int,int>(comblist->at(loop1).at(0),comblist->at(loop1).at(1)) );
-                    }
-                }
-			}
-			else
-			{
-				cerr << "\033[32m[Info]: DCC Constraint List Full!\033[0m\n";
-				return;
-			}
-		}
-		// Deal with the combination containing the number of nodes greater than two
-		// (reduce to two nodes)
-		else
-		{
-			vector<long> gencomb, simplify = comblist->at(loop1);
-			vector<vector<long> > simplifylist;
-			for(long loop2 = 0;loop2 <= (simplify.size()-2);loop2++)
-				combination(loop2+1, simplify.size(), 1, gencomb, &simplifylist);
-			updateCombinationList(&simplify, &simplifylist);
-			this->genDccConstraintClause(&simplifylist);
-		}
-	}
+    map< long, int >::iterator found = abovevar.find( node->getNodeNumber() );
+    if( found != abovevar.end() ) return found->second ;
+    CTN *uppernode = upper[node->getNodeNumber()] ;
+    int uppervar = ( uppernode != nullptr ) ? this->genAboveVar( uppernode, leader, upper, abovevar, list, ctr ) : 0 ;
+    int var      = this->newCnfAuxVar();
+    int nodenum  = (int)node->getNodeNumber();
+    int firstvar = this->getNodeVar( node );
+    vector<int> nodevar = ( leader ) ? vector<int>{ firstvar + 2 } : vector<int>{ firstvar, firstvar + 1 } ;
+    vector< vector<int> > clauses ;
+    for( auto lit: nodevar ) clauses.push_back( { -lit, var } );
+    if( uppervar != 0 ) clauses.push_back( { -uppervar, var } );
+    for( auto const& clause: clauses )
+    {
+        if( list.insert( clause ) ) ctr++ ;
+        if( _printClause ) fprintf( fptr, "%s on/above node(%d): %s\n", ( leader ) ? "Leader" : "DCC", nodenum, ClauseArena::toString(clause).c_str() );
+    }
+    this->_abovevar.push_back( make_tuple( var, nodevar, uppervar ) );
+    abovevar[node->getNodeNumber()] = var ;
+    return var ;
+}
+
+/////////////////////////////////////////////////////////////////////
+//
+// ClockTree Class - Private Method
+// At most one DCC (leader) along a clock path: no DCC (leader) on a
+// node if DCC (leader) on/above its upper node. Nodes visited by the
+// previous clock paths are skipped, so each node is encoded once.
+// Input parameter:
+// clkpath: clock nodes (from upper to lower) the DCC (leader) may be on
+//
+/////////////////////////////////////////////////////////////////////
+void ClockTree::genAtMostOneOnClockPath( const vector<CTN*> &clkpath, bool leader, map<long, CTN*> &upper, map<long, int> &abovevar, ClauseArena &list, long &ctr )
+{
+    //-- Unmasked nodes below the last visited one ----------------------------------
+    long first = 0 ;
+    CTN *top   = nullptr ;
+    for( long loop = (long)clkpath.size() - 1; loop >= 0; loop-- )
+    {
+        if( clkpath[loop]->ifMasked() ) continue ;
+        if( upper.count( clkpath[loop]->getNodeNumber() ) ) { top = clkpath[loop] ; first = loop + 1 ; break ; }
+    }
+    for( long loop = first; loop < (long)clkpath.size(); loop++ )
+    {
+        CTN *node = clkpath[loop] ;
+        if( node->ifMasked() ) continue ;
+        upper[node->getNodeNumber()] = top ;
+        if( top != nullptr )
+        {
+            int abovevar_top = this->genAboveVar( top, leader, upper, abovevar, list, ctr );
+            int nodenum      = (int)node->getNodeNumber();
+            int firstvar     = this->getNodeVar( node );
+            vector< vector<int> > clauses ;
+            if( leader ) clauses = { { -abovevar_top, -(firstvar + 2) } };
+            else         clauses = { { -abovevar_top, -firstvar }, { -abovevar_top, -(firstvar + 1) } };
+            for( auto const& clause: clauses )
+            {
+                if( list.insert( clause ) ) ctr++ ;
+                if( _printClause ) fprintf( fptr, "%d below %ld: %s \n", nodenum, top->getNodeNumber(), ClauseArena::toString(clause).c_str() );
+            }
+        }
+        top = node ;
+    }
+}
+
+/////////////////////////////////////////////////////////////////////
+//
+// ClockTree Class - Private Method
+// Give 3 CNF vars (DCC bit0, DCC bit1, header) to each unmasked clock
+// node, in DFS order from the root so that the vars of a clock path
+// are close to each other. Masked nodes, the root and FFs can't have
+// a DCC or a header, so they get no var.
+//
+/////////////////////////////////////////////////////////////////////
+void ClockTree::buildCnfVarMap(void)
+{
+    this->_nodevar.assign( this->_totalnodenum + 1, 0 );
+    this->_varnode.clear();
+    if( this->_clktreeroot == nullptr ) return ;
+    vector< CTN* > nodestack( 1, this->_clktreeroot );
+    while( !nodestack.empty() )
+    {
+        CTN *node = nodestack.back() ;
+        nodestack.pop_back();
+        if( !node->ifMasked() && node != this->_clktreeroot && !node->isFFSink() )
+        {
+            long id = ( node->getNodeNumber() - 1 ) / 3 ;
+            if( id >= (long)this->_nodevar.size() ) this->_nodevar.resize( id + 1, 0 );
+            this->_nodevar[id] = (int)this->_varnode.size() * 3 + 1 ;
+            this->_varnode.push_back( node );
+        }
+        vector< CTN* > &children = node->getChildren() ;
+        nodestack.insert( nodestack.end(), children.rbegin(), children.rend() );
+    }
+}
+
+/////////////////////////////////////////////////////////////////////
+//
+// ClockTree Class - Private Method
+// Append the literal of the var "offset" (0/1: DCC bits, 2: header)
+// of the node to the clause. A node without vars has neither DCC nor
+// header: its positive literal is false and dropped, its negative
+// literal is true, then 0 is appended to mark the clause satisfied.
+//
+/////////////////////////////////////////////////////////////////////
+void ClockTree::addNodeLiteral( vector<int> &clause, CTN *node, int offset, bool positive )
+{
+    int var = this->getNodeVar( node );
+    if( var != 0 )          clause.push_back( ( positive ) ? ( var + offset ) : -( var + offset ) );
+    else if( !positive )    clause.push_back( 0 );
+}
+
+/////////////////////////////////////////////////////////////////////
+//
+// ClockTree Class - Private Method
+// New auxiliary CNF var (after the vars of clock nodes)
+//
+/////////////////////////////////////////////////////////////////////
+int ClockTree::newCnfAuxVar(void)
+{
+    return (int)( this->getNodeVarNumber() + ( ++this->_cnfauxvarnum ) );
+}
+
+/////////////////////////////////////////////////////////////////////
+//
+// ClockTree Class - Private Method
+// Set the auxiliary vars in "bolarray" (indexed by var) from the
+// DCC deployment in it
+//
+/////////////////////////////////////////////////////////////////////
+void ClockTree::evalCnfAuxVar( bool *bolarray )
+{
+    for( auto const& above: this->_abovevar )//upper vars come first
+    {
+        bool value = ( get<2>(above) != 0 && bolarray[get<2>(above)] );
+        for( auto var: get<1>(above) ) value = value || bolarray[var] ;
+        bolarray[get<0>(above)] = value ;
+    }
+    //-- Latency var: the configuration of the clock path holds -------------------
+    for( long idx = 0; idx < this->_latencydeflist.size(); idx++ )
+    {
+        const int *lits = this->_latencydeflist.getLiterals(idx) ;
+        long  size  = this->_latencydeflist.getClauseSize(idx) ;
+        bool  value = true ;
+        for( long loop = 0; loop < size - 1 && value; loop++ )
+            value = ( bolarray[abs(lits[loop])] != ( lits[loop] > 0 ) );
+        bolarray[lits[size-1]] = value ;
+    }
 }
 
 /////////////////////////////////////////////////////////////////////
@@ -259,51 +389,31 @@ void ClockTree::genDccConstraintClause( vector<vector<long> > *comblist )
 //          80 => 80% DCC
 //
 /////////////////////////////////////////////////////////////////////
-void ClockTree::genClauseByDccVTA( ClockTreeNode *node, string *clause, double dcctype, int LibIndex )
+void ClockTree::genClauseByDccVTA( ClockTreeNode *node, vector<int> *clause, double dcctype, int LibIndex )
 {
 	if((node == nullptr) || (clause == nullptr) )
 		return ;
     
-	long nodenum = node->getNodeNumber();
-    
-    if( node->ifMasked() )
+    //-- Masked node: no DCC (no var) ------
+    if( node->ifMasked() || dcctype == 0.5 || dcctype == -1 || dcctype == 0 )
+        { this->addNodeLiteral( *clause, node, 0, true  ); this->addNodeLiteral( *clause, node, 1, true  ); }
+    else if( dcctype == 0.2 )
+        { this->addNodeLiteral( *clause, node, 0, false ); this->addNodeLiteral( *clause, node, 1, true  ); }
+    else if( dcctype == 0.4 )
+        { this->addNodeLiteral( *clause, node, 0, true  ); this->addNodeLiteral( *clause, node, 1, false ); }
+    else if( dcctype == 0.8 )
+        { this->addNodeLiteral( *clause, node, 0, false ); this->addNodeLiteral( *clause, node, 1, false ); }
+    else//Don't care
+        return ;
+    if( ifdoVTA() )
     {
-        *clause += to_string(nodenum) + " " + to_string(nodenum + 1) + " ";
         //-- Put Header ------
-        if( ifdoVTA() )
-        {
-            if( LibIndex == 0 )
-                *clause += to_string( ( nodenum + 2 )*(-1) ) + " " ;
-            //-- No Put Header ----
-            else if( LibIndex == -1 )
-                *clause += to_string( nodenum + 2  ) + " " ;
-
-            return ;
-        }
-    }else
-    {
-        if( dcctype == 0.5 || dcctype == -1 || dcctype == 0 )
-            *clause += to_string(nodenum) + " " + to_string(nodenum + 1) + " ";
-        else if( dcctype == 0.2 )
-            *clause += to_string(nodenum*(-1)) + " " + to_string((nodenum + 1)) + " ";
-        else if( dcctype == 0.4 )
-            *clause += to_string(nodenum) + " " + to_string((nodenum+1)*(-1)) + " ";
-        else if( dcctype == 0.8 )
-            *clause += to_string(nodenum * -1) + " " + to_string((nodenum + 1) * -1) + " ";
-        else//Don't care
-            return ;
-        if( ifdoVTA() )
-        {
-            if( LibIndex == 0 )
-                *clause += to_string( ( nodenum + 2 )*(-1) ) + " " ;
-            //-- No Put Header ----
-            else if( LibIndex == -1 )
-                *clause += to_string( nodenum + 2  ) + " " ;
-            
-            return ;
-        }
+        if( LibIndex == 0 )
+            this->addNodeLiteral( *clause, node, 2, false );
+        //-- No Put Header ----
+        else if( LibIndex == -1 )
+            this->addNodeLiteral( *clause, node, 2, true  );
     }
-	
 }
 
 /////////////////////////////////////////////////////////////////////
@@ -451,7 +561,8 @@ ClockTree::~ClockTree(void)
 	this->_cglist.clear();
 	this->_dcclist.clear();
 	this->_dccconstraintlist.clear();
-	this->_timingconstraintlist.clear();
+	this->_timingclausenum = 0 ;
+	this->clearSolver();
 }
 /*---------------------------------------------------------------------------
  FuncName:
@@ -536,6 +647,7 @@ void ClockTree::readParameter()
                     ptrTech->_Sv[12]         = this->calSv( DC_2_age, ptrTech->_VTH_OFFSET + this->getBaseVthOffset(), ptrTech->_VTH_CONVGNT[5] ) ;//80% DCC
                     ptrTech->_Sv[13]         = this->calSv( DC_3_age, ptrTech->_VTH_OFFSET + this->getBaseVthOffset(), ptrTech->_VTH_CONVGNT[6] ) ;//80% DCC
                     this->getLibList().push_back( ptrTech ) ;
+                    this->buildAgingRateTable();//the aging rates below are read from it
                     
                     //double bof = this->getBaseVthOffset() ;
                     
@@ -597,6 +709,7 @@ void ClockTree::readParameter()
             }
         }
     }
+    this->buildAgingRateTable();
 }
 /////////////////////////////////////////////////////////////////////
 //
@@ -654,6 +767,93 @@ int ClockTree::checkParameter(int argc, char **argv, string *message)
             //this->_calVTA    = 1;
         else if(strcmp(argv[loop], "-print=Clause") == 0)
             this->_printClause  = 1;
+        else if(strcmp(argv[loop], "-sat=minisat") == 0)
+            this->_extsat       = 1;                            // Fork/exec ./minisat instead of the built-in solver
+        else if(strcmp(argv[loop], "-tc_search=discrete") == 0)
+            this->_tcdiscrete   = 1;                            // Bisect over the critical Tc of the timing clauses
+        else if(strcmp(argv[loop], "-phase_hint=off") == 0)
+            this->_phasehint    = 0;                            // Do not warm start a SAT call with the latest model
+        else if(strcmp(argv[loop], "-unsat_core") == 0)
+            this->_unsatcoreon  = 1;                            // Report the critical paths pinning the optimal Tc
+        else if(strcmp(argv[loop], "-sta_check") == 0)
+            this->_stacheck     = 1;                            // Cross-check the incremental timing with full recomputation
+        else if(strcmp(argv[loop], "-portfolio") == 0)
+        {
+            if((loop+1 >= argc) || !isRealNumber(string(argv[loop+1])) || (stoi(string(argv[loop+1])) < 1) || (stoi(string(argv[loop+1])) > PORTFOLIO_MAX))
+            {
+                *message = "\033[31m[ERROR]: Wrong number of solver configurations!!\033[0m\n";
+                *message += "Try \"--help\" for more information.\n";
+                return -1;
+            }
+            this->_portfolio = stoi(string(argv[loop+1]));
+            loop++;
+        }
+        else if(strcmp(argv[loop], "-sat_conflicts") == 0)
+        {
+            if((loop+1 >= argc) || !isRealNumber(string(argv[loop+1])) || (stol(string(argv[loop+1])) <= 0))
+            {
+                *message = "\033[31m[ERROR]: Wrong conflict budget of SAT calls!!\033[0m\n";
+                *message += "Try \"--help\" for more information.\n";
+                return -1;
+            }
+            this->_satconflictbudget = stol(string(argv[loop+1]));
+            loop++;
+        }
+        else if(strcmp(argv[loop], "-sat_timeout") == 0)
+        {
+            if((loop+1 >= argc) || !isRealNumber(string(argv[loop+1])) || (stod(string(argv[loop+1])) <= 0))
+            {
+                *message = "\033[31m[ERROR]: Wrong time budget of SAT calls!!\033[0m\n";
+                *message += "Try \"--help\" for more information.\n";
+                return -1;
+            }
+            this->_sattimebudget = stod(string(argv[loop+1]));
+            loop++;
+        }
+        else if(strcmp(argv[loop], "-jobs") == 0)
+        {
+            if((loop+1 >= argc) || !isRealNumber(string(argv[loop+1])) || (stoi(string(argv[loop+1])) < 1))
+            {
+                *message = "\033[31m[ERROR]: Wrong number of jobs!!\033[0m\n";
+                *message += "Try \"--help\" for more information.\n";
+                return -1;
+            }
+            this->_jobs = stoi(string(argv[loop+1]));
+            loop++;
+        }
+        else if(strcmp(argv[loop], "-components") == 0)
+        {
+            if((loop+1 >= argc) || !isRealNumber(string(argv[loop+1])) || (stoi(string(argv[loop+1])) < 1))
+            {
+                *message = "\033[31m[ERROR]: Wrong number of component jobs!!\033[0m\n";
+                *message += "Try \"--help\" for more information.\n";
+                return -1;
+            }
+            this->_compjobs = stoi(string(argv[loop+1]));
+            loop++;
+        }
+        else if(strcmp(argv[loop], "-threads") == 0)
+        {
+            if((loop+1 >= argc) || !isRealNumber(string(argv[loop+1])) || (stoi(string(argv[loop+1])) < 1))
+            {
+                *message = "\033[31m[ERROR]: Wrong number of threads!!\033[0m\n";
+                *message += "Try \"--help\" for more information.\n";
+                return -1;
+            }
+            this->_threads = stoi(string(argv[loop+1]));
+            loop++;
+        }
+        else if(strcmp(argv[loop], "-lazy") == 0)
+        {
+            if((loop+1 >= argc) || !isRealNumber(string(argv[loop+1])) || (stol(string(argv[loop+1])) < 1))
+            {
+                *message = "\033[31m[ERROR]: Wrong number of lazy paths!!\033[0m\n";
+                *message += "Try \"--help\" for more information.\n";
+                return -1;
+            }
+            this->_lazyedgenum = stol(string(argv[loop+1]));
+            loop++;
+        }
         else if(strcmp(argv[loop], "-checkCNF") == 0)
 			this->_program_ctl = 5;
             //this->_checkCNF  = 1;
@@ -862,6 +1062,24 @@ int ClockTree::checkParameter(int argc, char **argv, string *message)
 		*message += "Try \"--help\" for more information.\n";
 		return -1;
 	}
+	if(this->_jobs > 1 && (this->_extsat || this->_portfolio > 1))
+	{
+		*message = "\033[31m[ERROR]: -jobs works with the built-in SAT engine only (no -portfolio)!!\033[0m\n";
+		*message += "Try \"--help\" for more information.\n";
+		return -1;
+	}
+	if(this->_lazyedgenum > 0 && (this->_jobs > 1 || this->_tcdiscrete || this->_extsat))
+	{
+		*message = "\033[31m[ERROR]: -lazy works with the binary search of the built-in SAT engine only!!\033[0m\n";
+		*message += "Try \"--help\" for more information.\n";
+		return -1;
+	}
+	if(this->_compjobs > 0 && (this->_jobs > 1 || this->_tcdiscrete || this->_extsat || this->_portfolio > 1 || this->_lazyedgenum > 0))
+	{
+		*message = "\033[31m[ERROR]: -components works with the binary search of the built-in SAT engine only (no -jobs/-portfolio/-lazy)!!\033[0m\n";
+		*message += "Try \"--help\" for more information.\n";
+		return -1;
+	}
 	if(!this->_aging)
 	{
 		// Non-aging for Tcq, Dij, and Tsu
@@ -1212,6 +1430,7 @@ void ClockTree::clockGatingCellReplacement(void)
 {
 	if( !this->_clkgating )
 		return;
+	this->_clklatenready = false ;//clock latency table is stale
 	// Get the replacement from cg file if the cg file exist
 	if(!this->_cgfilename.empty())
 	{
@@ -1490,6 +1709,7 @@ void ClockTree::dccPlacementByMasked( )
                 }
 		}
 	}
+	this->buildCnfVarMap();
 }
 
 
@@ -1517,32 +1737,21 @@ void ClockTree::VTAConstraint(void)
             cerr << RED"[Error]" RESET" Cannot open " << this->clauseFileName << endl ;
     }
     
+    //-- The root, FFs and masked buffers have no header var (see buildCnfVarMap) ----
     if( this->ifdoVTA() == false )
     {
         for( auto const& node: this->_buflist )//_buflist = map< string, clknode * >
         {
-            string clause ;
-            clause = to_string((node.second->getNodeNumber()+2) * -1) + " 0";
+            int var = this->getNodeVar( node.second );
+            if( var == 0 ) continue ;
+            vector<int> clause ;
+            clause = { -(var + 2) };
             this->_VTAconstraintlist.insert(clause);
             
-            if( _printClause )  fprintf( fptr, "NodoVTA: %s(%ld) %s\n", node.second->getGateData()->getGateName().c_str(),  node.second->getNodeNumber(), clause.c_str() );
+            if( _printClause )  fprintf( fptr, "NodoVTA: %s(%ld) %s\n", node.second->getGateData()->getGateName().c_str(),  node.second->getNodeNumber(), ClauseArena::toString(clause).c_str() );
         }
     }
 
-    //-- Don't Put Header at Root ---------------------------------------------------
-    string clause = "" ;
-    clause = to_string( (this->_clktreeroot->getNodeNumber() + 2 ) * -1 ) + " 0" ;
-    this->_VTAconstraintlist.insert( clause );
-    if( _printClause ) fprintf( fptr, "Root: %s(%ld) %s\n", _clktreeroot->getGateData()->getGateName().c_str(), _clktreeroot->getNodeNumber(), clause.c_str() );
-    
-    //-- Don't Put Header at FF ---------------------------------------------------
-    for( auto FF: this->_ffsink )
-    {
-        clause = to_string( (FF.second->getNodeNumber() + 2 ) * -1 ) + " 0" ;
-        this->_VTAconstraintlist.insert( clause );
-        if( _printClause ) fprintf( fptr, "FF: %s(%ld) %s\n", FF.second->getGateData()->getGateName().c_str(), FF.second->getNodeNumber(), clause.c_str() );
-    }
-    
     if( this->ifdoVTA() == true )
     {
         for( auto path : this->_pathlist )
@@ -1553,28 +1762,19 @@ void ClockTree::VTAConstraint(void)
             else if( path->getPathType() == PItoPO )    continue    ;
             else if( path->getPathType() == NONE   )    continue    ;
         }
-        for( auto const& node: this->_buflist )//_buflist = map< string, clknode * >
-        {
-            if( node.second->ifMasked() ){
-                string clause = to_string( (node.second->getNodeNumber()+2) * -1) + " 0";
-                this->_VTAconstraintlist.insert(clause);
-                if( _printClause ) fprintf( fptr,"Masked TVA node(%ld): %s \n", node.second->getNodeNumber(), clause.c_str());
-            }
-        }
     }
     if( _printClause ) fclose( fptr );
 }
 
 /*---------------------------------------------------------------------------
  FuncName:
-    DCCLeaderConstraint(),       VTAConstraintFFtoFF(),
-    DCCLeaderConstraintPItoFF(), VTAConstraintFFtoPO(),
+    DCCLeaderConstraint()
  Where defined:
     ClockTree Class - Public Method
  Introduction:
-    VTA constraint and generate clauses
+    DCC-leader constraint and generate clauses
     Formulate unwanted scenario as clauses (CNF)
-    So-called unwanted scenario: More than one "header" exist along one clock path
+    So-called unwanted scenario: DCC on or below the leader along one clock path
  Creator:
     Tien-Hung Tseng
  ----------------------------------------------------------------------------*/
@@ -1589,251 +1789,52 @@ void ClockTree::DCCLeaderConstraint(void)
             cerr << RED"[Error]" RESET" Cannot open " << this->clauseFileName << endl ;
     }
     
-    //-- Don't Put Leader at Root ---------------------------------------------------
-    string clause = "" ;
-    
+    //-- No DCC on (or below) a leader: once per unmasked buffer of the clock paths
+    //-- (the ones visited by VTAConstraint) by its "leader on/above" var ----------
     if( this->ifdoVTA() == true && this->_dcc_leader == true )
     {
-        for( auto path : this->_pathlist )
+        for( auto const& node: this->_buflist )//_buflist = map< string, clknode * >
         {
-            if( path->getPathType() == FFtoFF )         this->DCCLeaderConstraintFFtoFF( path ) ;
-            else if( path->getPathType() == PItoFF )    this->DCCLeaderConstraintPItoFF( path ) ;
-            else if( path->getPathType() == FFtoPO )    this->DCCLeaderConstraintFFtoPO( path ) ;
-            else if( path->getPathType() == PItoPO )    continue    ;
-            else if( path->getPathType() == NONE   )    continue    ;
+            if( this->_leaderupper.count( node.second->getNodeNumber() ) == 0 ) continue ;
+            int leadervar = this->genAboveVar( node.second, true, this->_leaderupper, this->_leaderabove, this->_VTAconstraintlist, this->_leader_constraint_ctr );
+            int nodenum   = (int)node.second->getNodeNumber() ;
+            int var       = this->getNodeVar( node.second );
+            vector<int> clause1 = { -leadervar, -var }, clause2 = { -leadervar, -(var + 1) };
+            this->_VTAconstraintlist.insert( clause1 );
+            this->_VTAconstraintlist.insert( clause2 );
+            if( _printClause ) fprintf( this->fptr, "%d(DCC) on/below leader: %s, %s \n", nodenum, ClauseArena::toString(clause1).c_str(), ClauseArena::toString(clause2).c_str() );
         }
     }
     if( _printClause ) fclose( fptr );
 }
-void ClockTree::DCCLeaderConstraintFFtoFF( CriticalPath *path )
-{
-    if( this->ifdoVTA() == false ) return ;
-    if( this->_dcc_leader == false ) return ;
-    assert( path->getPathType() == FFtoFF );
-    const vector<ClockTreeNode *> stClkPath = path->getStartPonitClkPath() ;
-    const vector<ClockTreeNode *> edClkPath = path->getEndPonitClkPath()   ;
-    string  clause = "" ;
-    
-    for( int leadLoc = 0 ; leadLoc < stClkPath.size()-1; leadLoc++ )
-    {
-        if( stClkPath.at(leadLoc)->ifMasked() ) continue ;
-        
-        for( int dccLoc = leadLoc; dccLoc < stClkPath.size()-1; dccLoc++ )
-        {
-            if( stClkPath.at(dccLoc)->ifMasked() ) continue ;
-            {
-                clause = to_string((stClkPath.at(dccLoc)->getNodeNumber()) * -1) + " " + to_string( (stClkPath.at(leadLoc)->getNodeNumber()+2) * -1 )+ " 0";
-                this->_VTAconstraintlist.insert( clause );
-                if( _printClause ) fprintf( this->fptr, "%ld(20 or 80) with %ld (leader): %s \n",stClkPath.at(dccLoc)->getNodeNumber(), stClkPath.at(leadLoc)->getNodeNumber(), clause.c_str() );
-                
-                clause = to_string((stClkPath.at(dccLoc)->getNodeNumber()+1) * -1) + " " + to_string( (stClkPath.at(leadLoc)->getNodeNumber()+2) * -1 )+ " 0";
-                this->_VTAconstraintlist.insert( clause );
-                if( _printClause ) fprintf( this->fptr, "%ld(40 or 80) with %ld (leader): %s \n",stClkPath.at(dccLoc)->getNodeNumber(), stClkPath.at(leadLoc)->getNodeNumber(), clause.c_str() );
-            }
-        }
-    }
-    for( int leadLoc = 0 ; leadLoc < edClkPath.size()-1; leadLoc++ )
-    {
-        if( edClkPath.at(leadLoc)->ifMasked() ) continue ;
-        
-        for( int dccLoc = leadLoc; dccLoc < edClkPath.size()-1; dccLoc++ )
-        {
-            if( edClkPath.at(dccLoc)->ifMasked() ) continue ;
-            {
-                clause = to_string((edClkPath.at(dccLoc)->getNodeNumber()) * -1) + " " + to_string( (edClkPath.at(leadLoc)->getNodeNumber()+2) * -1 )+ " 0";
-                this->_VTAconstraintlist.insert( clause );
-                if( _printClause ) fprintf( this->fptr, "%ld(20 or 80) with %ld (leader): %s \n",edClkPath.at(dccLoc)->getNodeNumber(), edClkPath.at(leadLoc)->getNodeNumber(), clause.c_str() );
-                
-                clause = to_string((edClkPath.at(dccLoc)->getNodeNumber()+1) * -1) + " " + to_string( (edClkPath.at(leadLoc)->getNodeNumber()+2) * -1 )+ " 0";
-                this->_VTAconstraintlist.insert( clause );
-                if( _printClause ) fprintf( this->fptr, "%ld(40 or 80) with %ld (leader): %s \n",edClkPath.at(dccLoc)->getNodeNumber(), edClkPath.at(leadLoc)->getNodeNumber(), clause.c_str() );
-            }
-        }
-    }
-}
-void ClockTree::DCCLeaderConstraintPItoFF( CriticalPath *path )
-{
-    if( this->ifdoVTA() == false ) return ;
-    assert( path->getPathType() == PItoFF );
-    //const vector<ClockTreeNode *> stClkPath = path->getStartPonitClkPath() ;
-    const vector<ClockTreeNode *> edClkPath = path->getEndPonitClkPath()   ;
-    string  clause = "" ;
-    for( int leadLoc = 0 ; leadLoc < edClkPath.size()-1; leadLoc++ )
-    {
-        if( edClkPath.at(leadLoc)->ifMasked() ) continue ;
-        
-        for( int dccLoc = leadLoc; dccLoc < edClkPath.size()-1; dccLoc++ )
-        {
-            if( edClkPath.at(dccLoc)->ifMasked() ) continue ;
-            {
-                clause = to_string((edClkPath.at(dccLoc)->getNodeNumber()) * -1) + " " + to_string( (edClkPath.at(leadLoc)->getNodeNumber()+2) * -1 )+ " 0";
-                this->_VTAconstraintlist.insert( clause );
-                if( _printClause ) fprintf( this->fptr, "%ld(20 or 80) with %ld (leader): %s \n",edClkPath.at(dccLoc)->getNodeNumber(), edClkPath.at(leadLoc)->getNodeNumber(), clause.c_str() );
-                
-                clause = to_string((edClkPath.at(dccLoc)->getNodeNumber()+1) * -1) + " " + to_string( (edClkPath.at(leadLoc)->getNodeNumber()+2) * -1 )+ " 0";
-                this->_VTAconstraintlist.insert( clause );
-                if( _printClause ) fprintf( this->fptr, "%ld(40 or 80) with %ld (leader): %s \n",edClkPath.at(dccLoc)->getNodeNumber(), edClkPath.at(leadLoc)->getNodeNumber(), clause.c_str() );
-            }
-        }
-    }
-}
-
-void ClockTree::DCCLeaderConstraintFFtoPO( CriticalPath *path )
-{
-    if( this->ifdoVTA() == false ) return ;
-    assert( path->getPathType() == FFtoPO );
-    const vector<ClockTreeNode *> stClkPath = path->getStartPonitClkPath() ;
-    //const vector<ClockTreeNode *> edClkPath = path->getEndPonitClkPath()   ;
-    string  clause = "" ;
-    
-    for( int leadLoc = 0 ; leadLoc < stClkPath.size()-1; leadLoc++ )
-    {
-        if( stClkPath.at(leadLoc)->ifMasked() ) continue ;
-        
-        for( int dccLoc = leadLoc; dccLoc < stClkPath.size()-1; dccLoc++ )
-        {
-            if( stClkPath.at(dccLoc)->ifMasked() ) continue ;
-            {
-                clause = to_string((stClkPath.at(dccLoc)->getNodeNumber()) * -1) + " " + to_string( (stClkPath.at(leadLoc)->getNodeNumber()+2) * -1 )+ " 0";
-                this->_VTAconstraintlist.insert( clause );
-                if( _printClause ) fprintf( this->fptr, "%ld(20 or 80) with %ld (leader): %s \n",stClkPath.at(dccLoc)->getNodeNumber(), stClkPath.at(leadLoc)->getNodeNumber(), clause.c_str() );
-                
-                clause = to_string((stClkPath.at(dccLoc)->getNodeNumber()+1) * -1) + " " + to_string( (stClkPath.at(leadLoc)->getNodeNumber()+2) * -1 )+ " 0";
-                this->_VTAconstraintlist.insert( clause );
-                if( _printClause ) fprintf( this->fptr, "%ld(40 or 80) with %ld (leader): %s \n",stClkPath.at(dccLoc)->getNodeNumber(), stClkPath.at(leadLoc)->getNodeNumber(), clause.c_str() );
-            }
-        }
-    }
-}
-
 void ClockTree::VTAConstraintFFtoFF( CriticalPath *path )
 {
     if( !this->ifdoVTA() ) return ;
     assert( path != NULL );
     assert( path->getPathType() == FFtoFF );
-    const vector<ClockTreeNode *> stClkPath = path->getStartPonitClkPath() ;
-    const vector<ClockTreeNode *> edClkPath = path->getEndPonitClkPath()   ;
-    ClockTreeNode *commonParent = path->findLastSameParentNode() ;
-    ClockTreeNode *Node1 = NULL, *Node2 = NULL ;
-    int     idCommonParent = 0 ;
-    string  clause = "" ;
-    
-        //Each pairs of nodes in stClkPath
-    for( int L1 = 0 ; L1 < stClkPath.size()-2; L1++ )
-    {
-        Node1 = stClkPath.at(L1) ;
-        if( Node1->ifMasked() ) continue;
-        for( int L2 = L1 + 1 ; L2 < stClkPath.size()-1; L2++ )
-        {
-            Node2 = stClkPath.at(L2) ;
-            if( Node2->ifMasked() ) continue;
-            clause = to_string( (Node1->getNodeNumber()+2) * -1 ) + " " + to_string( (Node2->getNodeNumber()+2) * -1 )+ " 0" ;
-            
-            if( _VTAconstraintlist.find(clause) == _VTAconstraintlist.end() )
-            {
-                this->_VTAconstraintlist.insert( clause );
-                this->_leader_constraint_ctr++;
-                if( _printClause ) fprintf( this->fptr, "%ld with %ld: %s \n",Node1->getNodeNumber(), Node2->getNodeNumber(), clause.c_str() );
-            } 
-            
-        }
-            
-        if( stClkPath.at(L1) == commonParent ) idCommonParent = L1 ;
-    }
-    //Each pairs of nodes in edClkPath
-    //L1 range: root <-> common parent
-    //L2 range: right child of common parent <-> right end
-    for( int L1 = 0 ; L1 <= idCommonParent; L1++ )
-    {
-        Node1 = edClkPath.at(L1) ;
-        if( Node1->ifMasked() ) continue;
-        for( int L2 = idCommonParent + 1 ; L2 < edClkPath.size()-1; L2++ )
-        {
-            Node2 = edClkPath.at(L2) ;
-            if( Node2->ifMasked() ) continue;
-            clause = to_string( (Node1->getNodeNumber()+2) * -1 ) + " " + to_string( (Node2->getNodeNumber()+2) * -1 )+ " 0" ;
-            
-            if( _VTAconstraintlist.find(clause) == _VTAconstraintlist.end() )
-            {
-                this->_VTAconstraintlist.insert( clause );
-                this->_leader_constraint_ctr++;
-                if( _printClause ) fprintf( this->fptr, "%ld with %ld: %s \n",Node1->getNodeNumber(), Node2->getNodeNumber(), clause.c_str() );
-            }
-        }
-    }
-        //Each pairs of nodes in edClkPath
-    for( int L1 = idCommonParent + 1 ; L1 < edClkPath.size()-2; L1++ )
-    {
-        Node1 = edClkPath.at(L1) ;
-        if( Node1->ifMasked() ) continue;
-        for( int L2 = L1 + 1 ; L2 < edClkPath.size()-1; L2++ )
-        {
-            Node2 = edClkPath.at(L2) ;
-            if( Node2->ifMasked() ) continue;
-            clause = to_string( (Node1->getNodeNumber()+2) * -1 ) + " " + to_string( (Node2->getNodeNumber()+2) * -1 )+ " 0" ;
-            
-            if( _VTAconstraintlist.find(clause) == _VTAconstraintlist.end() )
-            {
-                this->_VTAconstraintlist.insert( clause );
-                this->_leader_constraint_ctr++;
-                if( _printClause ) fprintf( this->fptr, "%ld with %ld: %s \n",Node1->getNodeNumber(), Node2->getNodeNumber(), clause.c_str() );
-            }
-        }
-    }
+    //-- Both clock paths except the FFs (common part is visited once) -------------
+    vector<ClockTreeNode *> stClkPath = path->getStartPonitClkPath() ;
+    vector<ClockTreeNode *> edClkPath = path->getEndPonitClkPath()   ;
+    stClkPath.pop_back() ;
+    edClkPath.pop_back() ;
+    this->genAtMostOneOnClockPath( stClkPath, true, this->_leaderupper, this->_leaderabove, this->_VTAconstraintlist, this->_leader_constraint_ctr );
+    this->genAtMostOneOnClockPath( edClkPath, true, this->_leaderupper, this->_leaderabove, this->_VTAconstraintlist, this->_leader_constraint_ctr );
 }
 void ClockTree::VTAConstraintPItoFF( CriticalPath *path )
 {
     if( !this->ifdoVTA() ) return ;
     assert( path->getPathType() == PItoFF );
-   
-    const vector<ClockTreeNode *> edClkPath = path->getEndPonitClkPath()   ;
-    string clause = "" ;
-    ClockTreeNode *Node1 = NULL, *Node2 = NULL ;
-    
-    for( int L1 = 0 ; L1 < edClkPath.size()-2; L1++ )
-    {
-        Node1 = edClkPath.at(L1);
-        if( Node1->ifMasked() ) continue;
-        for( int L2 = L1 + 1 ; L2 < edClkPath.size()-1; L2++ )
-        {
-            Node2 = edClkPath.at(L2);
-            if( Node2->ifMasked() ) continue;
-            clause = to_string( (Node1->getNodeNumber()+2) * -1 ) + " " + to_string( (Node2->getNodeNumber()+2) * -1 )+ " 0" ;
-            
-            if( _VTAconstraintlist.find(clause) == _VTAconstraintlist.end() )
-            {
-                this->_VTAconstraintlist.insert( clause );
-                this->_leader_constraint_ctr++;
-                if( _printClause ) fprintf( this->fptr, "%ld with %ld: %s \n",Node1->getNodeNumber(), Node2->getNodeNumber(), clause.c_str() );
-            }
-        }
-    }
+    vector<ClockTreeNode *> edClkPath = path->getEndPonitClkPath()   ;
+    edClkPath.pop_back() ;
+    this->genAtMostOneOnClockPath( edClkPath, true, this->_leaderupper, this->_leaderabove, this->_VTAconstraintlist, this->_leader_constraint_ctr );
 }
 void ClockTree::VTAConstraintFFtoPO( CriticalPath *path )
 {
     if( !this->ifdoVTA() ) return ;
     assert( path->getPathType() == FFtoPO );
-    const vector<ClockTreeNode *> stClkPath = path->getStartPonitClkPath() ;
-    string clause = "" ;
-    ClockTreeNode *Node1 = NULL, *Node2 = NULL ;
-    for( int L1 = 0 ; L1 < stClkPath.size()-2; L1++ )
-    {
-        Node1 = stClkPath.at(L1);
-        if( Node1->ifMasked() ) continue;
-        for( int L2 = L1 + 1 ; L2 < stClkPath.size()-1; L2++ )
-        {
-            Node2 = stClkPath.at(L2);
-            if( Node2->ifMasked() ) continue;
-            clause = to_string( (Node1->getNodeNumber()+2) * -1 ) + " " + to_string( (Node2->getNodeNumber()+2) * -1 )+ " 0" ;
-            
-            if( _VTAconstraintlist.find(clause) == _VTAconstraintlist.end() )
-            {
-                this->_VTAconstraintlist.insert( clause );
-                this->_leader_constraint_ctr++;
-                if( _printClause ) fprintf( this->fptr, "%ld with %ld: %s \n",Node1->getNodeNumber(), Node2->getNodeNumber(), clause.c_str() );
-            }
-        }
-    }
+    vector<ClockTreeNode *> stClkPath = path->getStartPonitClkPath() ;
+    stClkPath.pop_back() ;
+    this->genAtMostOneOnClockPath( stClkPath, true, this->_leaderupper, this->_leaderabove, this->_VTAconstraintlist, this->_leader_constraint_ctr );
 }
 /*---------------------------------------------------------------------------
  FuncName:
@@ -1858,105 +1859,40 @@ void ClockTree::dccConstraint(void)
         
         if( !fptr ) cerr << RED"[Error]" RESET" Cannot open " << this->clauseFileName << endl ;
     }
-	if( !this->_placedcc )
+	//-- The root, FFs and masked buffers have no DCC var (see buildCnfVarMap) ------
+	this->_nonplacedccbufnum = 0 ;
+	for( auto const& node: this->_buflist )//_buflist = map< string, clknode * >
 	{
-		this->_nonplacedccbufnum = this->_buflist.size();
+        int var = this->getNodeVar( node.second );
+        if( var == 0 || !this->_placedcc ) this->_nonplacedccbufnum++ ;
+        if( var == 0 ||  this->_placedcc ) continue ;
+        vector<int> clause ;
+        clause = { -var };
+        this->_dccconstraintlist.insert(clause);
         
-        for( auto const& node: this->_buflist )//_buflist = map< string, clknode * >
-        {
-            string clause ;
-            clause = to_string((node.second->getNodeNumber()+0) * -1) + " 0";
-            if( this->_dccconstraintlist.size() < (this->_dccconstraintlist.max_size()-2) )
-                this->_dccconstraintlist.insert(clause);
-            else
-                cerr << "\033[32m[Info]: DCC Constraint List Full!\033[0m\n";
-            
-            if( _printClause )  fprintf( fptr, "NodoDCC: %s(%ld) %s\n", node.second->getGateData()->getGateName().c_str(),  node.second->getNodeNumber(), clause.c_str() );
-            
-            clause = to_string((node.second->getNodeNumber()+1) * -1) + " 0";
-            if( this->_dccconstraintlist.size() < (this->_dccconstraintlist.max_size()-2) )
-                this->_dccconstraintlist.insert(clause);
-            else
-                cerr << "\033[32m[Info]: DCC Constraint List Full!\033[0m\n";
-            
-            if( _printClause )  fprintf( fptr, "NodoDCC: %s(%ld) %s\n", node.second->getGateData()->getGateName().c_str(),  node.second->getNodeNumber(), clause.c_str() );
-        }
-	}
-    
-	// Generate two clauses for the clock tree root (clock source)
-	if( this->_dccconstraintlist.size() < (this->_dccconstraintlist.max_size()-2) )
-	{
-		string clause1 = to_string(this->_clktreeroot->getNodeNumber() * -1) + " 0";
-		string clause2 = to_string((this->_clktreeroot->getNodeNumber() + 1) * -1) + " 0";
-		this->_dccconstraintlist.insert(clause1);
-		this->_dccconstraintlist.insert(clause2);
+        if( _printClause )  fprintf( fptr, "NodoDCC: %s(%ld) %s\n", node.second->getGateData()->getGateName().c_str(),  node.second->getNodeNumber(), ClauseArena::toString(clause).c_str() );
         
-        if( _printClause ) fprintf( fptr,"Root: %s, %s \n", clause1.c_str(), clause2.c_str() );
+        clause = { -(var + 1) };
+        this->_dccconstraintlist.insert(clause);
+        
+        if( _printClause )  fprintf( fptr, "NodoDCC: %s(%ld) %s\n", node.second->getGateData()->getGateName().c_str(),  node.second->getNodeNumber(), ClauseArena::toString(clause).c_str() );
 	}
-	else
+	// Generate clauses based on DCC constraint in each clock path, once
+	// per clock node by the "DCC on/above" vars (O(#nodes) clauses)
+	map< long, CTN* > upper    ;//nearest unmasked upper node (nullptr: none)
+	map< long, int >  dccabove ;//"DCC on/above" var of a node
+	for( auto const& node: this->_ffsink  )
 	{
-		cerr << "\033[32m[Info]: DCC Constraint List Full!\033[0m\n";
-		return;
-	}
-	// Generate two clauses for each buffer can not insert DCC
-	for( auto const& node: this->_buflist )//_buflist = map< string, clknode * >
-	{
-        if( node.second->ifMasked() )
-		{
-			string clause1, clause2;
-			clause1 = to_string(node.second->getNodeNumber() * -1) + " 0";
-			clause2 = to_string((node.second->getNodeNumber() + 1) * -1) + " 0";
-			if(this->_dccconstraintlist.size() < (this->_dccconstraintlist.max_size()-2))
-			{
-				this->_dccconstraintlist.insert(clause1);
-				this->_dccconstraintlist.insert(clause2);
-                if( _printClause ) fprintf( fptr,"Masked node(%ld): %s, %s \n", node.second->getNodeNumber(), clause1.c_str(), clause2.c_str() );
-			}
-			else
-			{
-				cerr << "\033[32m[Info]: DCC Constraint List Full!\033[0m\n";
-				return;
-			}
-		}
-	}
-	this->_nonplacedccbufnum = (this->_dccconstraintlist.size() / 2) - 1;
-	// Generate clauses based on DCC constraint in each clock path
-	for( auto const& node: this->_ffsink  )
-	{
-        //-- Don't Put DCC ahead of FF
-		string clause1, clause2;
-		clause1 = to_string(node.second->getNodeNumber() * -1) + " 0";
-		clause2 = to_string((node.second->getNodeNumber() + 1) * -1) + " 0";
-		if(this->_dccconstraintlist.size() < (this->_dccconstraintlist.max_size()-2))
-		{
-			this->_dccconstraintlist.insert(clause1);
-			this->_dccconstraintlist.insert(clause2);
-            if( _printClause ) fprintf( fptr,"Masked FF(%ld): %s, %s \n", node.second->getNodeNumber(), clause1.c_str(), clause2.c_str() );
-		}
-		else
-		{
-			cerr << "\033[32m[Info]: DCC Constraint List Full!\033[0m\n";
-			return;
-		}
 		ClockTreeNode *nodeptr = node.second->getParent() ;//FF's parent
-		vector<long>          path, gencomb;
-		vector<vector<long> > comblist;
+		vector< CTN* > path ;
 		while( nodeptr != this->_firstchildrennode )
 		{
-			//if( nodeptr->ifPlacedDcc() )
-            if( nodeptr->ifMasked() == false )
-				path.push_back( nodeptr->getNodeNumber() );
+			path.push_back( nodeptr );
 			nodeptr = nodeptr->getParent();
 		}
-		path.shrink_to_fit();
 		reverse(path.begin(), path.end());
-		// Combination of DCC constraint
-        // Can't Put more than 2 DCC along the same clock path
-		for( long loop = 0; loop <= ((long)path.size()) - 2; loop++ )
-			combination( loop+1, (int)(path.size()), 1, gencomb, &comblist );
-		updateCombinationList( &path, &comblist );
-		// Generate clauses
-		this->genDccConstraintClause(&comblist);
+		// Can't Put more than 2 DCC along the same clock path
+		this->genAtMostOneOnClockPath( path, false, upper, dccabove, this->_dccconstraintlist, this->_dcc_constraint_ctr );
 	}
     if( _printClause ) fclose(fptr);
 }
@@ -1977,18 +1913,462 @@ void ClockTree::genDccPlacementCandidate(void)
 			path->setDccPlacementCandidate();
 }
 
+/////////////////////////////////////////////////////////////////////
+//
+// ClockTree Class - Public Method
+// Collapse the critical paths into timing edges: the clauses of a path
+// depend only on its clock paths (given by the start/end clock leaf
+// and the path type) and on its aged data delay
+//      Tin + Tcq*r_tcq + Dij*r_dij - Tsu*r_tsu
+// The path of the largest data delay of a group has every clause of
+// the others with a higher (or the same) critical Tc, so only that
+// path (the first one for a tie) is enumerated in the timing clause DB
+//
+/////////////////////////////////////////////////////////////////////
+void ClockTree::collapseTimingEdge(void)
+{
+    map< tuple< CTN*, CTN*, int >, long > edgeloc ;//group => location in _timingedge
+    vector< double > edgedelay ;
+    long pathnum = 0 ;
+    this->_timingedge.clear();
+    for( auto const& path: this->_pathlist )
+    {
+        int type = path->getPathType() ;
+        if( (type != PItoFF) && (type != FFtoPO) && (type != FFtoFF) ) continue ;
+        pathnum++ ;
+        CTN *stleaf = ( type == PItoFF ) ? nullptr : path->getStartPonitClkPath().back() ;
+        CTN *edleaf = ( type == FFtoPO ) ? nullptr : path->getEndPonitClkPath().back()   ;
+        double delay = path->getTinDelay() + path->getTcq() * this->_agingtcq + path->getDij() * this->_agingdij - path->getTsu() * this->_agingtsu ;
+        auto found = edgeloc.find( make_tuple( stleaf, edleaf, type ) );
+        if( found == edgeloc.end() )
+        {
+            edgeloc[ make_tuple( stleaf, edleaf, type ) ] = (long)this->_timingedge.size() ;
+            this->_timingedge.push_back( path );
+            edgedelay.push_back( delay );
+        }
+        else if( delay > edgedelay[found->second] )
+        {
+            this->_timingedge[found->second] = path ;
+            edgedelay[found->second] = delay ;
+        }
+    }
+    printf( YELLOW"\t[--Timing Edge----] " RESET"%ld critical paths => %lu timing edges (%.1f%%)\n",
+            pathnum, this->_timingedge.size(), ( pathnum > 0 ) ? 100.0 * this->_timingedge.size() / pathnum : 0.0 );
+    
+    //-- "-lazy K": the K edges of the least aged slack without DCC/VTA go first ----
+    this->_edgeactive.clear();
+    if( this->_lazyedgenum <= 0 || this->_lazyedgenum >= (long)this->_timingedge.size() ) return ;
+    vector< pair< double, long > > edgeslack ;
+    for( long loop = 0; loop < (long)this->_timingedge.size(); loop++ )
+        edgeslack.push_back( make_pair( this->UpdatePathTiming( this->_timingedge[loop], false, false, true ), loop ) );
+    sort( edgeslack.begin(), edgeslack.end() );
+    this->_edgeactive.assign( this->_timingedge.size(), false );
+    for( long loop = 0; loop < this->_lazyedgenum; loop++ ) this->_edgeactive[ edgeslack[loop].second ] = true ;
+    printf( YELLOW"\t[--Lazy Edge------] " RESET"%ld of %lu timing edges in the clause DB\n", this->_lazyedgenum, this->_timingedge.size() );
+}
+
+/////////////////////////////////////////////////////////////////////
+//
+// ClockTree Class - Private Method
+// "-lazy K": check the DCC deployment/leader selection of a SAT model
+// (at the current Tc) on the timing edges not in the DB yet, and put
+// the violated ones into the DB. Return true if any edge is added,
+// then the DB is rebuilt by the next solver load and the Tc must be
+// solved again; otherwise the model meets every edge.
+//
+/////////////////////////////////////////////////////////////////////
+bool ClockTree::lazyRefine( const vector<int> &model )
+{
+    if( this->_edgeactive.empty() ) return false ;
+    //-- Deployment of the model on the clock tree ------------------------------------
+    this->_dcclist.clear();
+    this->_VTAlist.clear();
+    for( auto const& node: this->_buflist )
+    {
+        node.second->setIfPlaceDcc(0).setDccType(0).setIfPlaceHeader(0).setVTAType(-1);
+    }
+    this->decodeDccVTAFromModel( model );
+    long added = 0, active = 0 ;
+    for( long loop = 0; loop < (long)this->_timingedge.size(); loop++ )
+    {
+        if( !this->_edgeactive[loop] && this->UpdatePathTiming( this->_timingedge[loop], false, true, true ) < -TCDB_EPSILON )
+        {
+            this->_edgeactive[loop] = true ;
+            added++ ;
+        }
+        if( this->_edgeactive[loop] ) active++ ;
+    }
+    //-- Clear the deployment ---------------------------------------------------------
+    for( auto const& node: this->_dcclist )  node.second->setIfPlaceDcc(0).setDccType(0) ;
+    for( auto const& node: this->_VTAlist )  node.second->setIfPlaceHeader(0).setVTAType(-1) ;
+    this->_dcclist.clear();
+    this->_VTAlist.clear();
+    if( added == 0 ) return false ;
+    printf( YELLOW"\t[--Lazy Refine----] " RESET"%ld violated timing edges added (%ld of %lu in the clause DB)\n", added, active, this->_timingedge.size() );
+    this->_tcdbready = false ;
+    return true ;
+}
+
+/////////////////////////////////////////////////////////////////////
+//
+// ClockTree Class - Private Method
+// Enumerate every DCC/VTA configuration of every timing edge once, and
+// keep the clauses violated at Tc = _tcdbfloor (lower bound of the
+// Binary search) with their critical Tc. Sorted by critical Tc, the
+// clauses of any Tc >= floor are a prefix of the DB.
+//
+/////////////////////////////////////////////////////////////////////
+void ClockTree::buildTimingClauseDB(void)
+{
+    double curtc = this->_tc ;
+    this->_tcdbfloor = min( this->_tc, this->_tclowbound );
+    this->_tc = this->_tcdbfloor ;
+    this->_tcclausedb.clear();
+    this->_tcclausearena.clear();
+    //-- Activation vars of the SAT engine refer to the old DB ---------------------
+    this->clearSolver();
+    
+    //-- Timing edge iteration ("-lazy K": the edges in the DB) -------------------
+    if( this->_timingedge.empty() ) this->collapseTimingEdge();
+    vector< CP* > edges ;
+    for( long loop = 0; loop < (long)this->_timingedge.size(); loop++ )
+        if( this->_edgeactive.empty() || this->_edgeactive[loop] ) edges.push_back( this->_timingedge[loop] );
+    if( this->_threads <= 1 )
+    {
+        for( auto const& path: edges ) this->genTimingClause( path );
+    }
+    else
+    {
+        //-- Workers take chunks of paths; merging the chunks in path order gives
+        //-- the same DB as the sequential loop ----------------------------------
+        long chunknum = min( (long)edges.size(), (long)this->_threads * 16 );
+        vector< TIMING_CLAUSE_BUF > chunkbuf( chunknum );
+        vector< thread >            workers ;
+        atomic< long >              nextchunk( 0 );
+        for( int loop = 0; loop < this->_threads; loop++ )
+            workers.push_back( thread( &ClockTree::genTimingClauseByThread, this, cref(edges), ref(chunkbuf), ref(nextchunk) ) );
+        for( auto &worker: workers ) worker.join();
+        for( auto &buf: chunkbuf )
+        {
+            for( auto &entry: buf._db )
+            {
+                vector<int> clause = buf._arena.getClause( entry._clause );
+                this->recordTimingClause( clause, entry._stlitnum, entry._avltime, entry._reqtime, entry._log, entry._pathnum );
+            }
+            buf._arena.clear();
+            buf._db.clear();
+        }
+    }
+    sort( this->_tcclausedb.begin(), this->_tcclausedb.end(),
+          []( const TIMING_CLAUSE &a, const TIMING_CLAUSE &b ){ return a._tcth > b._tcth; } );
+    this->_tc = curtc ;
+    this->_tcdbready = true ;
+    printf( YELLOW"\t[--Clause DB------] " RESET"%lu timing clauses (critical Tc > %f)\n", this->_tcclausedb.size(), this->_tcdbfloor );
+    this->simplifyTimingClauseDB();
+    this->encodeLatencyVar();
+}
+
+/////////////////////////////////////////////////////////////////////
+//
+// ClockTree Class - Private Method
+// Simplify the sorted timing clause DB before it goes to the solver
+// (or to the CNF file):
+// (1) Vars fixed by the unit clauses of the DCC/VTA constraints (and
+//     by unit propagation over those constraints) are substituted:
+//     false literals are stripped, satisfied clauses are removed.
+// (2) A clause is removed if a clause with a higher (or the same)
+//     critical Tc has a subset of its literals (duplicates included).
+//     That clause is in every prefix holding the removed one, so
+//     each Tc keeps the same solutions.
+//
+/////////////////////////////////////////////////////////////////////
+void ClockTree::simplifyTimingClauseDB(void)
+{
+    //-- (1) Unit propagation over the constraints ---------------------------------
+    long varnum = this->getCnfVarNumber();
+    vector< signed char > value( varnum + 1, 0 );//1: true, -1: false, 0: free
+    vector< ClauseArena* > constraint = { &this->_dccconstraintlist, &this->_VTAconstraintlist };
+    bool propagate = true ;
+    while( propagate )
+    {
+        propagate = false ;
+        for( auto list: constraint )
+        {
+            for( long idx = 0; idx < list->size(); idx++ )
+            {
+                const int *lits = list->getLiterals(idx) ;
+                int  unit = 0, freenum = 0 ;
+                bool sat  = false ;
+                for( long loop = 0; loop < list->getClauseSize(idx) && !sat; loop++ )
+                {
+                    int val = value[abs(lits[loop])] * ( ( lits[loop] > 0 ) ? 1 : -1 );
+                    if( val > 0 )       sat = true ;
+                    else if( val == 0 ) { unit = lits[loop] ; freenum++ ; }
+                }
+                if( sat || freenum != 1 ) continue ;//a conflict (freenum = 0) is left to the solver
+                value[abs(unit)] = ( unit > 0 ) ? 1 : -1 ;
+                propagate = true ;
+            }
+        }
+    }
+    
+    //-- (2) Strip fixed literals, then forward subsumption in the order of the DB:
+    //-- each kept clause is indexed by its rarest literal, a clause is checked
+    //-- against the kept clauses indexed by one of its literals -----------------
+    auto litValue = [&]( int lit ){ return ( abs(lit) <= varnum ) ? value[abs(lit)] * ( ( lit > 0 ) ? 1 : -1 ) : 0 ; };
+    vector< long > occurnum( 2 * ( varnum + 1 ), 0 );
+    for( auto const& entry: this->_tcclausedb )
+    {
+        const int *lits = this->_tcclausearena.getLiterals( entry._clause ) ;
+        for( long k = 0; k < this->_tcclausearena.getClauseSize( entry._clause ); k++ )
+            occurnum[ 2 * abs(lits[k]) + ( lits[k] < 0 ) ]++ ;
+    }
+    
+    vector< TIMING_CLAUSE >   db ;
+    ClauseArena               arena ;
+    vector< vector<long> >    occur( 2 * ( varnum + 1 ) );//kept clauses (position in db) by literal
+    vector< uint64_t >        signature ;//literal bits of the kept clauses (subset pre-check)
+    vector< char >            mark( 2 * ( varnum + 1 ), 0 );
+    vector< int >             clause ;
+    long                      emptypos = -1 ;
+    long satnum = 0, dupnum = 0, subnum = 0, stripnum = 0 ;
+    this->_tcremovedth.clear();
+    for( auto &entry: this->_tcclausedb )
+    {
+        const int *lits = this->_tcclausearena.getLiterals( entry._clause ) ;
+        long  size = this->_tcclausearena.getClauseSize( entry._clause ) ;
+        bool  sat  = false ;
+        long  stlitnum = 0 ;
+        clause.clear();
+        for( long k = 0; k < size && !sat; k++ )
+        {
+            int val = litValue( lits[k] );
+            if( val > 0 )       sat = true ;
+            else if( val < 0 )  stripnum++ ;
+            else                { clause.push_back( lits[k] ); stlitnum += ( k < entry._stlitnum ) ; }
+        }
+        if( sat )
+        {
+            satnum++ ;
+            this->_tcremovedth.push_back( entry._tcth );
+            continue ;
+        }
+        uint64_t sig = 0 ;
+        for( auto lit: clause ) { sig |= 1ULL << ( ( 2 * abs(lit) + ( lit < 0 ) ) % 64 ) ; mark[ 2 * abs(lit) + ( lit < 0 ) ] = 1 ; }
+        long subsumer = emptypos ;//the empty clause subsumes every clause
+        for( long k = 0; k < (long)clause.size() && subsumer < 0; k++ )
+        {
+            for( auto pos: occur[ 2 * abs(clause[k]) + ( clause[k] < 0 ) ] )
+            {
+                if( ( signature[pos] & ~sig ) != 0 || arena.getClauseSize(pos) > (long)clause.size() ) continue ;
+                const int *lits = arena.getLiterals(pos) ;
+                long  size = arena.getClauseSize(pos), i = 0 ;
+                while( i < size && mark[ 2 * abs(lits[i]) + ( lits[i] < 0 ) ] ) i++ ;
+                if( i == size ) { subsumer = pos ; break ; }
+            }
+        }
+        for( auto lit: clause ) mark[ 2 * abs(lit) + ( lit < 0 ) ] = 0 ;
+        if( subsumer >= 0 )
+        {
+            if( arena.getClauseSize(subsumer) == (long)clause.size() ) dupnum++ ;
+            else                                                          subnum++ ;
+            this->_tcremovedth.push_back( entry._tcth );
+            continue ;
+        }
+        //-- Kept: index it by its rarest literal ----------------------------------
+        if( clause.empty() ) emptypos = (long)db.size() ;
+        else
+        {
+            int rarest = clause[0] ;
+            for( auto lit: clause )
+                if( occurnum[ 2 * abs(lit) + ( lit < 0 ) ] < occurnum[ 2 * abs(rarest) + ( rarest < 0 ) ] ) rarest = lit ;
+            occur[ 2 * abs(rarest) + ( rarest < 0 ) ].push_back( (long)db.size() );
+        }
+        arena.insert( clause );
+        signature.push_back( sig );
+        entry._clause = (long)db.size() ;
+        entry._stlitnum = stlitnum ;
+        db.push_back( move(entry) );
+    }
+    this->_tcclausedb.swap( db );
+    this->_tcclausearena = move(arena) ;
+    printf( YELLOW"\t[--Clause DB------] " RESET"Simplified: %ld satisfied, %ld duplicate, %ld subsumed clauses removed, %ld literals stripped => %lu timing clauses\n",
+            satnum, dupnum, subnum, stripnum, this->_tcclausedb.size() );
+}
+
+/////////////////////////////////////////////////////////////////////
+//
+// ClockTree Class - Private Method
+// Enumerate every DCC/VTA configuration of a path (aging)
+//
+/////////////////////////////////////////////////////////////////////
+void ClockTree::genTimingClause( CriticalPath *path )
+{
+    if( (path->getPathType() != PItoFF) && (path->getPathType() != FFtoPO) && (path->getPathType() != FFtoFF) ) return ;
+    //--No DCC insertion ----------------------------------
+    this->timingConstraint_ndoDCC_ndoVTA( path, 1 );//Aging
+    //this->timingConstraint_ndoDCC_ndoVTA( path, 0 );//Fresh
+    this->timingConstraint_ndoDCC_doVTA(  path, 1 );//Aging
+    //this->timingConstraint_ndoDCC_doVTA(  path, 0 );//Fresh
+    
+    //--DCC Insertion && VTA ------------------------------
+    if( this->_placedcc )
+    {
+        this->timingConstraint_doDCC_ndoVTA( path, 1 );//Aging
+        //this->timingConstraint_doDCC_ndoVTA( path, 0 );//Fresh
+        this->timingConstraint_doDCC_doVTA(  path, 1 );//Aging
+        //this->timingConstraint_doDCC_doVTA(  path, 0 );//Fresh
+    }
+}
+
+/////////////////////////////////////////////////////////////////////
+//
+// ClockTree Class - Private Method
+// Worker of "-threads N": generate the timing clauses of the next
+// free chunk of paths into its own buffer until no chunk is left.
+// The timing functions only read the clock tree and the paths.
+//
+/////////////////////////////////////////////////////////////////////
+void ClockTree::genTimingClauseByThread( const vector<CP*> &edges, vector<TIMING_CLAUSE_BUF> &chunkbuf, atomic<long> &nextchunk )
+{
+    long pathnum  = (long)edges.size() ;
+    long chunknum = (long)chunkbuf.size() ;
+    for( long chunk = nextchunk++; chunk < chunknum; chunk = nextchunk++ )
+    {
+        TcClauseBuf = &chunkbuf[chunk] ;
+        for( long loop = chunk * pathnum / chunknum; loop < ( chunk + 1 ) * pathnum / chunknum; loop++ )
+            this->genTimingClause( edges[loop] );
+    }
+    TcClauseBuf = nullptr ;
+}
+
+/////////////////////////////////////////////////////////////////////
+//
+// ClockTree Class - Private Method
+// Put a violated configuration into the timing clause DB (or the
+// buffer of the worker thread). The same clause from several
+// configurations keeps the highest critical Tc.
+// stlitnum: # literals of the launch clock path (first in the clause)
+//
+/////////////////////////////////////////////////////////////////////
+void ClockTree::recordTimingClause( vector<int> &clause, long stlitnum, double avltime, double reqtime, string &log, long pathnum )
+{
+    if( find( clause.begin(), clause.end(), 0 ) != clause.end() ) return ;//satisfied (see addNodeLiteral)
+    ClauseArena             &arena = ( TcClauseBuf ) ? TcClauseBuf->_arena : this->_tcclausearena ;
+    vector< TIMING_CLAUSE > &db    = ( TcClauseBuf ) ? TcClauseBuf->_db    : this->_tcclausedb    ;
+    double tcth = avltime - reqtime ;
+    long   idx  = 0 ;
+    if( arena.insert( clause, &idx ) )
+    {
+        TIMING_CLAUSE entry ;
+        entry._tcth = tcth ; entry._avltime = avltime ; entry._reqtime = reqtime ;
+        entry._clause = idx ; entry._log = log ; entry._pathnum = pathnum ; entry._stlitnum = stlitnum ;
+        db.push_back( entry );
+    }
+    else if( tcth > db[idx]._tcth )
+    {
+        TIMING_CLAUSE &entry = db[idx] ;
+        entry._tcth = tcth ; entry._avltime = avltime ; entry._reqtime = reqtime ;
+        entry._log = log ; entry._pathnum = pathnum ;
+    }
+}
+
+/////////////////////////////////////////////////////////////////////
+//
+// ClockTree Class - Private Method
+// Shorten the simplified timing clauses by latency vars: each side of
+// a clause (launch clock path, capture clock path) negates one
+// configuration of its clock path, i.e. one discrete aged latency of
+// the clock leaf. A side of 2+ literals shared by 2+ clauses is
+// replaced by -L, where L is defined once per configuration:
+//      configuration => L     (side literals + L)
+// so the paths through the same leaf (or the same final buffer)
+// share L, and a clause is ~(L_launch & L_capture) whatever the
+// depth of the tree. L is positive only in its definition, so each
+// Tc keeps the same DCC/VTA solutions. The capture side of FFtoFF
+// is the branch below the common node (the common part is on the
+// launch side), so its L is per (leaf, branch point).
+// Definitions are kept over DB rebuilds ("-lazy K").
+//
+/////////////////////////////////////////////////////////////////////
+void ClockTree::encodeLatencyVar(void)
+{
+    vector< TIMING_CLAUSE >   db ;
+    ClauseArena               arena ;
+    vector< int >             clause, key ;
+    long litnum = 0, newvarnum = 0 ;
+    //-- # clauses of each configuration --------------------------------------------
+    ClauseArena               sidekey ;
+    vector< long >            sidenum ;
+    for( auto const& entry: this->_tcclausedb )
+    {
+        const int *lits = this->_tcclausearena.getLiterals( entry._clause ) ;
+        long  size = this->_tcclausearena.getClauseSize( entry._clause ) ;
+        for( auto side: { make_pair( 0L, entry._stlitnum ), make_pair( entry._stlitnum, size ) } )
+        {
+            if( side.second - side.first <= 1 ) continue ;
+            key.assign( lits + side.first, lits + side.second );
+            sort( key.begin(), key.end() );
+            long idx = 0 ;
+            if( sidekey.insert( key, &idx ) ) sidenum.push_back( 0 );
+            sidenum[idx]++ ;
+        }
+    }
+    for( auto &entry: this->_tcclausedb )
+    {
+        const int *lits = this->_tcclausearena.getLiterals( entry._clause ) ;
+        long  size = this->_tcclausearena.getClauseSize( entry._clause ) ;
+        litnum += size ;
+        clause.clear();
+        for( auto side: { make_pair( 0L, entry._stlitnum ), make_pair( entry._stlitnum, size ) } )
+        {
+            if( side.second - side.first > 1 )
+            {
+                key.assign( lits + side.first, lits + side.second );
+                sort( key.begin(), key.end() );
+            }
+            if( side.second - side.first <= 1 || ( sidenum[ sidekey.find( key ) ] < 2 && this->_latencykey.find( key ) < 0 ) )
+            {
+                clause.insert( clause.end(), lits + side.first, lits + side.second );
+                continue ;
+            }
+            long idx = 0 ;
+            if( this->_latencykey.insert( key, &idx ) )
+            {
+                key.push_back( this->newCnfAuxVar() );
+                this->_latencydeflist.insert( key );
+                newvarnum++ ;
+            }
+            clause.push_back( -this->_latencydeflist.getLiterals(idx)[ this->_latencydeflist.getClauseSize(idx) - 1 ] );
+        }
+        if( !arena.insert( clause ) )//same configurations as a clause of higher critical Tc
+        {
+            this->_tcremovedth.insert( upper_bound( this->_tcremovedth.begin(), this->_tcremovedth.end(), entry._tcth, greater<double>() ), entry._tcth );
+            continue ;
+        }
+        entry._clause   = (long)db.size() ;
+        entry._stlitnum = 0 ;
+        db.push_back( move(entry) );
+    }
+    printf( YELLOW"\t[--Clause DB------] " RESET"Latency vars: %ld => %ld literals in timing clauses, %ld new vars (%ld vars, %ld literals in definitions)\n",
+            litnum, arena.getLiteralNumber(), newvarnum, this->_latencydeflist.size(), this->_latencydeflist.getLiteralNumber() );
+    this->_tcclausedb.swap( db );
+    this->_tcclausearena = move(arena) ;
+}
+
 /////////////////////////////////////////////////////////////////////
 //
 // ClockTree Class - Public Method
 //      Timing constraint and generate clauses based on each DCC
-// deployment
+// deployment (prefix scan of the timing clause DB)
 //
 /////////////////////////////////////////////////////////////////////
 long ClockTree::timingConstraint(void)
 {
     if( this->_placedcc == false && this->ifdoVTA() == false ) return -1 ;
     
-    this->_timingconstraintlist.clear();
+    if( !this->_tcdbready || this->_tc < this->_tcdbfloor ) this->buildTimingClauseDB();
+    this->_timingclausenum = 0 ;
     
     //-- Dump Clause log --------------------------------------------------------
     if( _printClause ){
@@ -1998,28 +2378,19 @@ long ClockTree::timingConstraint(void)
         this->fptr = fopen( this->clauseFileName.c_str(), "w" );
     }
     
-    //-- Path iteration ----------------------------------------------------------
-	for( auto const& path: this->_pathlist )
-	{
-		if( (path->getPathType() != PItoFF) && (path->getPathType() != FFtoPO) && (path->getPathType() != FFtoFF) ) continue;
-		//--No DCC insertion ----------------------------------
-		this->timingConstraint_ndoDCC_ndoVTA( path, 1 );//Aging
-		//this->timingConstraint_ndoDCC_ndoVTA( path, 0 );//Fresh
-        this->timingConstraint_ndoDCC_doVTA(  path, 1 );//Aging
-		//this->timingConstraint_ndoDCC_doVTA(  path, 0 );//Fresh
-        
-		//--DCC Insertion && VTA ------------------------------
-        if( this->_placedcc )
-        {
-            this->timingConstraint_doDCC_ndoVTA( path, 1 );//Aging
-			//this->timingConstraint_doDCC_ndoVTA( path, 0 );//Fresh
-            this->timingConstraint_doDCC_doVTA(  path, 1 );//Aging
-			//this->timingConstraint_doDCC_doVTA(  path, 0 );//Fresh
-        }
-        
-	}
+    //-- Clauses whose critical Tc is larger than Tc ------------------------------
+    for( auto const& entry: this->_tcclausedb )
+    {
+        if( entry._tcth <= this->_tc + TCDB_EPSILON ) break ;//slack >= 0 from here on
+        double slack = ( entry._reqtime + this->_tc ) - entry._avltime ;
+        this->_timingclausenum++ ;
+        if( _printClause ) fprintf( this->fptr, "%sslk = %f: %s \n", entry._log.c_str(), slack, this->_tcclausearena.toString(entry._clause).c_str() );
+    }
     if( _printClause ) fclose( this->fptr );
-    return this->_timingconstraintlist.size() ;
+    //-- Clauses of Tc removed by simplifyTimingClauseDB ---------------------------
+    long removed = lower_bound( this->_tcremovedth.begin(), this->_tcremovedth.end(), this->_tc + TCDB_EPSILON, greater<double>() ) - this->_tcremovedth.begin() ;
+    printf( YELLOW"\t[--Clause Simp----] " RESET"%ld timing clauses (%ld removed by simplification)\n", this->_timingclausenum, removed );
+    return this->_timingclausenum ;
 }
 /*------------------------------------------------------------------------------------
  FuncName:
@@ -2051,11 +2422,12 @@ double ClockTree::timingConstraint_ndoDCC_ndoVTA( CriticalPath *path, bool aging
 	double tcq = (aging)?((path->getTcq() * this->_agingtcq)):(path->getTcq());
 	double Dij = (aging)?((path->getDij() * this->_agingdij)):(path->getDij());
 	
-	datareqtime += tsu + this->_tc;
+	datareqtime += tsu;
     dataarrtime += path->getTinDelay() + tcq + Dij;
-	newslack = datareqtime - dataarrtime  ;
+	newslack = ( datareqtime + this->_tc ) - dataarrtime  ;
     
-    string clause  = "" ;
+    vector<int> clause ;
+    long        stlitnum = 0 ;
 	//-------- Timing Violation ---------------------------------------------------------
 	if( newslack < 0 )
 	{
@@ -2066,6 +2438,7 @@ double ClockTree::timingConstraint_ndoDCC_ndoVTA( CriticalPath *path, bool aging
 			//- Generate Clause --------------------------------------------------------
 			for( auto const& nodeptr: clkpath )
                 this->genClauseByDccVTA( nodeptr, &clause, this->DC_N, -1 ) ;
+            stlitnum = (long)clause.size() ;
 		}
 		else if( path->getPathType() == FFtoFF )//-- FFtoFF -----------------------------
 		{
@@ -2075,26 +2448,21 @@ double ClockTree::timingConstraint_ndoDCC_ndoVTA( CriticalPath *path, bool aging
             
 			for( auto const& nodeptr: path->getStartPonitClkPath() )
 					this->genClauseByDccVTA( nodeptr, &clause, this->DC_N, -1 ) ;
+            stlitnum = (long)clause.size() ;
         
 			//- Generate Clause/Right ---------------------------------------------------
 			for( long loop = (sameparentloc + 1);loop < path->getEndPonitClkPath().size(); loop++ )
 					this->genClauseByDccVTA( path->getEndPonitClkPath().at(loop), &clause, this->DC_N, -1 );
 		}
-		clause += "0";
-		
-        if( _timingconstraintlist.find(clause) == _timingconstraintlist.end() )
+        string log = "" ;
+        if( _printClause )
         {
-            this->_timingconstraintlist.insert(clause) ;
-            if( _printClause )
-            {
-                if( newslack < 0 )
-				{
-					if( aging ) fprintf( this->fptr, "10-yr aging ");
-					else		fprintf( this->fptr, "Fresh aging ");
-					fprintf( this->fptr, "Path(%ld), stDCC(%.1f), edDCC(%.1f), stVTA(%d), edVTA(%d), slk = %f, %s \n", path->getPathNum(), -1.0, -1.0, -1, -1, newslack, clause.c_str() );
-				}
-            }
+            char buf[128] ;
+            snprintf( buf, sizeof(buf), "%sPath(%ld), stDCC(%.1f), edDCC(%.1f), stVTA(%d), edVTA(%d), ",
+                      ( aging ) ? "10-yr aging " : "Fresh aging ", path->getPathNum(), -1.0, -1.0, -1, -1 );
+            log = buf ;
         }
+        this->recordTimingClause( clause, stlitnum, dataarrtime, datareqtime, log, path->getPathNum() );
 	}
     
     return newslack ;
@@ -2194,6 +2562,80 @@ double ClockTree::UpdatePathTiming( CriticalPath * path, bool update, bool DCCVT
     
     return newslack ;
 }
+
+/////////////////////////////////////////////////////////////////////
+//
+// ClockTree Class - Public Method
+// Time the timed paths (PItoFF, FFtoPO, FFtoFF) by UpdatePathTiming
+// with the given arguments ("-threads N": by N workers) and return
+// the minimum slack (9999 if none is below). worst gets the first
+// path of minimum slack, slacks the slack of each path (by index in
+// _pathlist). A sweep never sets the clock nodes (set of
+// UpdatePathTiming), so the workers only read the clock tree.
+//
+/////////////////////////////////////////////////////////////////////
+double ClockTree::sweepPathTiming( bool update, bool DCCVTA, bool aging, bool cPV, CP **worst, vector<double> *slacks )
+{
+    long pathnum = (long)this->_pathlist.size() ;
+    if( slacks ) slacks->assign( pathnum, 9999 );
+    TIMING_SWEEP sweep ;
+    sweep._update = update ; sweep._dccvta = DCCVTA ; sweep._aging = aging ; sweep._cpv = cPV ;
+    sweep._slacks = slacks ;
+    sweep._nextchunk = 0 ;
+    if( this->_threads <= 1 || pathnum < 2 )
+    {
+        sweep._chunkmin.assign( 1, make_pair( 9999.0, -1L ) );
+        this->sweepPathTimingByThread( sweep );
+    }
+    else
+    {
+        sweep._chunkmin.assign( min( pathnum, (long)this->_threads * 16 ), make_pair( 9999.0, -1L ) );
+        vector< thread > workers ;
+        for( int loop = 0; loop < this->_threads; loop++ )
+            workers.push_back( thread( &ClockTree::sweepPathTimingByThread, this, ref(sweep) ) );
+        for( auto &worker: workers ) worker.join();
+    }
+    //-- Min-reduction in path order -------------------------------------------------
+    double minslack = 9999 ;
+    long   minpath  = -1 ;
+    for( auto const& chunk: sweep._chunkmin )
+    {
+        if( chunk.second != -1 && chunk.first < minslack )
+        {
+            minslack = chunk.first ;
+            minpath  = chunk.second ;
+        }
+    }
+    if( worst && minpath != -1 ) *worst = this->_pathlist[minpath] ;
+    return minslack ;
+}
+
+/////////////////////////////////////////////////////////////////////
+//
+// ClockTree Class - Private Method
+// Worker of sweepPathTiming: time the paths of the next free chunk
+// until no chunk is left, keeping the first path of minimum slack
+// of each chunk.
+//
+/////////////////////////////////////////////////////////////////////
+void ClockTree::sweepPathTimingByThread( TIMING_SWEEP &sweep )
+{
+    long pathnum  = (long)this->_pathlist.size() ;
+    long chunknum = (long)sweep._chunkmin.size() ;
+    for( long chunk = sweep._nextchunk++; chunk < chunknum; chunk = sweep._nextchunk++ )
+    {
+        pair<double, long> &chunkmin = sweep._chunkmin[chunk] ;
+        for( long loop = chunk * pathnum / chunknum; loop < ( chunk + 1 ) * pathnum / chunknum; loop++ )
+        {
+            CP *path = this->_pathlist[loop] ;
+            if((path->getPathType() != PItoFF) && (path->getPathType() != FFtoPO) && (path->getPathType() != FFtoFF))
+                continue;
+            double slack = this->UpdatePathTiming( path, sweep._update, sweep._dccvta, sweep._aging, false, sweep._cpv );
+            if( sweep._slacks ) (*sweep._slacks)[loop] = slack ;
+            if( slack < chunkmin.first ) chunkmin = make_pair( slack, loop );
+        }
+    }
+}
 /*------------------------------------------------------------------------------------
  FuncName:
     timingConstraint_doDcc_ndoVTA
@@ -2540,14 +2982,16 @@ double ClockTree::timingConstraint_givDCC_givVTA(   CriticalPath *path,
     double Tsu = (caging)? (path->getTsu() * this->_agingtsu) : (path->getTsu()) ;
     double Tcq = (caging)? (path->getTcq() * this->_agingtcq) : (path->getTcq()) ;
     double Dij = (caging)? (path->getDij() * this->_agingdij) : (path->getDij()) ;
-    req_time = cj + Tsu + this->_tc;
+    double req_base = cj + Tsu ;
+    req_time = req_base + this->_tc;
     
     //------- Arrival time --------------------------------------------------------------
     avl_time = ci + path->getTinDelay() + Tcq + Dij ;
     slack    = req_time - avl_time  ;
     
     //-- Formulation ---------------------------------------------------------------------
-    string clause = "" ;
+    vector<int> clause ;
+    long        stlitnum = 0 ;//PItoFF/FFtoPO: one side
     if( slack < 0 )
     {
         //-- PItoFF ----------------------------------------------------------------------
@@ -2609,6 +3053,7 @@ double ClockTree::timingConstraint_givDCC_givVTA(   CriticalPath *path,
                 else if( this->ifdoVTA() )
                     this->writeClause_givVTA( clause, clknode, -1 );
             }
+            stlitnum = (long)clause.size() ;
             for( long k = commonparent+1; k < path->getEndPonitClkPath().size(); k++ )
             {
                 ClockTreeNode* clknode = path->getEndPonitClkPath().at(k) ;
@@ -2627,31 +3072,26 @@ double ClockTree::timingConstraint_givDCC_givVTA(   CriticalPath *path,
             }//for(k)
         }//FFtoFF
         
-        clause += "0" ;
-        
-        
-        if( _timingconstraintlist.find(clause) == _timingconstraintlist.end() )
+        string log = "" ;
+        if( _printClause )
         {
-            this->_timingconstraintlist.insert(clause) ;
-            if( _printClause )
-            {
-				if( caging )  fprintf( this->fptr,"10-yr aging " );
-				else          fprintf( this->fptr,"Fresh aging " );
-                fprintf( this->fptr,"Path(%4ld), ", path->getPathNum() );
-                if( stDCCLoc )  fprintf( this->fptr,"stDCC (%4ld, %.1f ), ", stDCCLoc->getNodeNumber(), stDCCType  );
-                else            fprintf( this->fptr,"stDCC (%4d, %.1f ), ",                          -1, -1.0       );
-                if( edDCCLoc )  fprintf( this->fptr,"edDCC (%4ld, %.1f ), ", edDCCLoc->getNodeNumber(), edDCCType  );
-                else            fprintf( this->fptr,"edDCC (%4d, %.1f ), ",                          -1, -1.0       );
-                if( stHeader )  fprintf( this->fptr,"stVTA (%4ld, %2d ), ", stHeader->getNodeNumber(), stLibIndex );
-                else            fprintf( this->fptr,"stVTA (%4d, %2d ), ",                           -1, -1         );
-                if( edHeader )  fprintf( this->fptr,"edVTA (%4ld, %2d ), ", edHeader->getNodeNumber(), edLibIndex  );
-                else            fprintf( this->fptr,"edVTA (%4d, %2d ), ",                           -1, -1         );
-                
-                if( slack < 0 ) fprintf( this->fptr,"slk = %f: %s \n", slack, clause.c_str() );
-                else            fprintf( this->fptr,"slk = %f: %s \n", slack, " " );
-            }
+            char buf[64] ;
+            log += ( caging ) ? "10-yr aging " : "Fresh aging " ;
+            snprintf( buf, sizeof(buf), "Path(%4ld), ", path->getPathNum() );                                   log += buf ;
+            if( stDCCLoc )  snprintf( buf, sizeof(buf), "stDCC (%4ld, %.1f ), ", stDCCLoc->getNodeNumber(), stDCCType  );
+            else            snprintf( buf, sizeof(buf), "stDCC (%4d, %.1f ), ",                          -1, -1.0       );
+            log += buf ;
+            if( edDCCLoc )  snprintf( buf, sizeof(buf), "edDCC (%4ld, %.1f ), ", edDCCLoc->getNodeNumber(), edDCCType  );
+            else            snprintf( buf, sizeof(buf), "edDCC (%4d, %.1f ), ",                          -1, -1.0       );
+            log += buf ;
+            if( stHeader )  snprintf( buf, sizeof(buf), "stVTA (%4ld, %2d ), ", stHeader->getNodeNumber(), stLibIndex );
+            else            snprintf( buf, sizeof(buf), "stVTA (%4d, %2d ), ",                           -1, -1         );
+            log += buf ;
+            if( edHeader )  snprintf( buf, sizeof(buf), "edVTA (%4ld, %2d ), ", edHeader->getNodeNumber(), edLibIndex  );
+            else            snprintf( buf, sizeof(buf), "edVTA (%4d, %2d ), ",                           -1, -1         );
+            log += buf ;
         }
-        
+        this->recordTimingClause( clause, stlitnum, avl_time, req_base, log, path->getPathNum() );
     
     }//if( newslack < 0 )
     
@@ -2665,50 +3105,154 @@ double ClockTree::timingConstraint_givDCC_givVTA(   CriticalPath *path,
  Introduction:
     (1) Write associated clause by given DCC scenario
     (2) Write associated clause by given VTA
- Boolean Variables:
-    (A) nodenum     => B0
-    (B) nodenum + 1 => B1
-    (C) nodenum + 2 => B2
+ Boolean Variables (var = getNodeVar(node)):
+    (A) var     => B0
+    (B) var + 1 => B1
+    (C) var + 2 => B2
         B0 and B1 are used to encode DCC insertion
         B2 is used to encode VTA
  -------------------------------------------------------------------------------------*/
-void ClockTree::writeClause_givDCC( string &clause, ClockTreeNode *node, double DCCType )
+void ClockTree::writeClause_givDCC( vector<int> &clause, ClockTreeNode *node, double DCCType )
 {
     if( node == NULL ) return ;
-    long nodenum = node->getNodeNumber() ;
     
     if( DCCType == this->DC_N || DCCType == -1 || DCCType == 0 )
-            clause += to_string(nodenum) + " " + to_string(nodenum + 1) + " ";
+        { this->addNodeLiteral( clause, node, 0, true  ); this->addNodeLiteral( clause, node, 1, true  ); }
     else if( DCCType == this->DC_1 )
-            clause += to_string(nodenum*-1) + " " + to_string((nodenum + 1 )) + " ";
+        { this->addNodeLiteral( clause, node, 0, false ); this->addNodeLiteral( clause, node, 1, true  ); }
     else if( DCCType == this->DC_2 )
-            clause += to_string(nodenum) + " " + to_string( (nodenum+1)*(-1) ) + " ";
+        { this->addNodeLiteral( clause, node, 0, true  ); this->addNodeLiteral( clause, node, 1, false ); }
     else if( DCCType == this->DC_3 )
-            clause += to_string(nodenum * -1) + " " + to_string((nodenum + 1 ) * -1 ) + " ";
+        { this->addNodeLiteral( clause, node, 0, false ); this->addNodeLiteral( clause, node, 1, false ); }
     else
-        cerr << "[Error] Unrecongnized duty cycle in func \"writeClause_givDCC( string&, ClockTreeNode*, double ) in clocktree.cpp\"  \n" ;
+        cerr << "[Error] Unrecongnized duty cycle in func \"writeClause_givDCC( vector<int>&, ClockTreeNode*, double ) in clocktree.cpp\"  \n" ;
 }
-void ClockTree::writeClause_givVTA( string &clause, ClockTreeNode *node, int LibIndex )
+void ClockTree::writeClause_givVTA( vector<int> &clause, ClockTreeNode *node, int LibIndex )
 {
     if( node == NULL ) return ;
-    long nodenum = node->getNodeNumber() ;
     
     //--- Node is not header ----------------------------------------------------------
     if( LibIndex == -1 )
-        clause += to_string( nodenum + 2 ) + " ";
+        this->addNodeLiteral( clause, node, 2, true  );
     else if( LibIndex == 0 )
-        clause += to_string( ( nodenum + 2 )*(-1) ) + " " ;
+        this->addNodeLiteral( clause, node, 2, false );
     //--- Node is header --------------------------------------------------------------
     else
-        cerr << "[Error] Unrecongnized Vth Type in func \"writeClause_givVTA( string&, ClockTreeNode*, double ) in clocktree.cpp\"  \n" ;
+        cerr << "[Error] Unrecongnized Vth Type in func \"writeClause_givVTA( vector<int>&, ClockTreeNode*, double ) in clocktree.cpp\"  \n" ;
+}
+/////////////////////////////////////////////////////////////////////
+//
+// ClockTree Class - Public Method
+// Build the prefix data (CLK_LATENCY) of every clock node, in DFS
+// order from the root. Must be rebuilt after clock gating or buffer
+// insertion changes, until then calClkLaten_givDcc_givVTA walks the
+// clock path.
+//
+/////////////////////////////////////////////////////////////////////
+void ClockTree::buildClockLatencyTable(void)
+{
+    this->_clklaten.assign( this->_totalnodenum / 3 + 1, CLK_LATENCY{ 0, 9999, true } );
+    this->_clklatenar    = this->getAgingRate_givDCType_givVth( DCT_N, -1, true );
+    this->_clklatenready = false ;
+    if( this->_clktreeroot == nullptr ) return ;
+    vector< CTN* > nodestack( 1, this->_clktreeroot );
+    while( !nodestack.empty() )
+    {
+        CTN *node = nodestack.back() ;
+        nodestack.pop_back();
+        long id = ( node->getNodeNumber() - 1 ) / 3 ;
+        if( id >= (long)this->_clklaten.size() ) this->_clklaten.resize( id + 1, CLK_LATENCY{ 0, 9999, true } );
+        CLK_LATENCY &entry = this->_clklaten[id] ;
+        double buftime = node->getGateData()->getWireTime() + node->getGateData()->getGateTime() ;
+        entry = ( node->getParent() == nullptr ) ? CLK_LATENCY{ 0, 9999, true } : this->_clklaten[ ( node->getParent()->getNodeNumber() - 1 ) / 3 ] ;
+        entry._rawsum += buftime ;
+        if( node != this->_clktreeroot ) entry._minbuf = min( entry._minbuf, buftime );
+        entry._plain = entry._plain && !node->ifClockGating() && !node->ifInsertBuffer() ;
+        vector< CTN* > &children = node->getChildren() ;
+        nodestack.insert( nodestack.end(), children.begin(), children.end() );
+    }
+    this->_clklatenready = true ;
+}
+
+/////////////////////////////////////////////////////////////////////
+//
+// ClockTree Class - Private Method
+// O(1) latency of a clock path (from the root to a clock leaf)
+// without clock gating and inserted buffers: the aging rate only
+// changes at the DCC and the header, so the path is cut into at most
+// 3 segments, each one weighted by its aging rate. Return false if
+// the table can't be used (the caller walks the clock path).
+// Output: latency without DCC delay, min buffer delay and Vth type of
+// the DCC.
+//
+/////////////////////////////////////////////////////////////////////
+bool ClockTree::calClkLatenByTable( const vector<CTN*> &clkpath, double DCCType, CTN *DCCLoc, int LibIndex, CTN *Header,
+                                    bool caging, double &laten, double &minbufdelay, int &LibVthTypeDCC )
+{
+    long m = (long)clkpath.size() ;
+    if( !this->_clklatenready || m < 2 || clkpath.front() != this->_clktreeroot || clkpath.back()->getDepth() != m - 1 ) return false ;
+    auto entry = [&]( CTN *node ) -> const CLK_LATENCY& { return this->_clklaten[ ( node->getNodeNumber() - 1 ) / 3 ] ; };
+    if( ( clkpath.back()->getNodeNumber() - 1 ) / 3 >= (long)this->_clklaten.size() || !entry( clkpath.back() )._plain ) return false ;
+    //-- Location of the DCC/header on the clock path (-1: not on it) -------------------
+    long pd = ( DCCLoc != nullptr && DCCLoc->getDepth() < m && clkpath[ DCCLoc->getDepth() ] == DCCLoc ) ? DCCLoc->getDepth() : -1 ;
+    long ph = ( Header != nullptr && Header->getDepth() < m && clkpath[ Header->getDepth() ] == Header ) ? Header->getDepth() : -1 ;
+    //-- The clock leaf only counts its wire delay ---------------------------------------
+    if( pd == m - 1 || ph == m - 1 ) return false ;
+    //-- Aging rates are read from the table by DC type ----------------------------------
+    DC_TYPE dcctype = ( pd >= 0 ) ? this->getDCType( DCCType ) : DCT_N ;
+    if( dcctype == DCT_NONE || ( ph >= 0 && ( LibIndex < -1 || LibIndex >= (long)this->getLibList().size() ) ) ) return false ;
+    //-- Raw delay of clkpath[0..k] ------------------------------------------------------
+    auto rawsum = [&]( long k ) -> double
+    {
+        if( k < 0 )     return 0 ;
+        if( k < m - 1 ) return entry( clkpath[k] )._rawsum ;
+        return entry( clkpath[m-2] )._rawsum + clkpath.back()->getGateData()->getWireTime() ;
+    };
+    
+    DC_TYPE DC          = DCT_N ;
+    int     LibVthType  = -1 ;
+    double  agingrate   = this->_clklatenar ;
+    long    segbegin    = 0 ;
+    laten         = 0 ;
+    LibVthTypeDCC = -1 ;
+    minbufdelay   = entry( clkpath[m-2] )._minbuf ;
+    //-- Events in the order of the clock path (DCC first at the same node) -------------
+    long event[2] = { min( pd, ph ), max( pd, ph ) };
+    for( int i = 0 ; i < 2 ; i++ )
+    {
+        long loc = event[i] ;
+        if( loc < 0 || ( i == 1 && loc == event[0] ) ) continue ;
+        laten += ( rawsum( loc - 1 ) - rawsum( segbegin - 1 ) )*agingrate ;
+        segbegin = loc ;
+        if( loc == pd )
+        {
+            const DC_TYPE agedtype[DCT_NUM] = { DCT_1_AGE, DCT_2_AGE, DCT_N, DCT_3_AGE, DCT_1_AGE, DCT_2_AGE, DCT_3_AGE };
+            DC = dcctype ;
+            //--- DCC Loc == VTA Leader, or behind it --------------------------------------
+            if( ph >= 0 && ph <= pd )
+            {
+                LibVthTypeDCC = LibIndex ;
+                if( this->_dc_formulation ) DC = agedtype[DC] ;
+            }
+            agingrate = this->getAgingRate_givDCType_givVth( DC, LibVthType, caging ) ;
+        }
+        if( loc == ph )
+        {
+            LibVthType = LibIndex ;
+            agingrate  = this->getAgingRate_givDCType_givVth( DC, LibVthType, caging ) ;
+        }
+    }
+    laten += ( rawsum( m - 1 ) - rawsum( segbegin - 1 ) )*agingrate ;
+    return true ;
 }
+
 /*------------------------------------------------------------------------------------
  FuncName:
  timingConstraint_givDCC_givVTA
  Introduction:
  After DCC insertion, VTA are given, estimate whether timing violation occurs
  -------------------------------------------------------------------------------------*/
-double ClockTree::calClkLaten_givDcc_givVTA(    vector<ClockTreeNode *> clkpath,
+double ClockTree::calClkLaten_givDcc_givVTA(    const vector<ClockTreeNode *> &clkpath,
                                             double DCCType,  ClockTreeNode *DCCLoc,
                                             int    LibIndex, ClockTreeNode *Header,
 											bool   caging,//consider aging
@@ -2735,7 +3279,9 @@ double ClockTree::calClkLaten_givDcc_givVTA(    vector<ClockTreeNode *> clkpath,
 	double  bufferinsert  = 0     ;
 	double  sleep_prob    = 0     ;
 	
-    for( int i = 0 ; i < clkpath.size() ; i++ )
+    //-- O(1) by the clock latency table, or walk the clock path ------------------------
+    bool    bytable = !set && !cPV && this->calClkLatenByTable( clkpath, DCCType, DCCLoc, LibIndex, Header, caging, laten, minbufdelay, LibVthTypeDCC );
+    for( int i = 0 ; !bytable && i < clkpath.size() ; i++ )
     {
 		if( clkpath.at(i) != clkpath.back() )
 			buftime = clkpath.at(i)->getGateData()->getWireTime() + clkpath.at(i)->getGateData()->getGateTime() ;
@@ -2841,6 +3387,9 @@ double ClockTree::calClkLaten_givDcc_givVTA(    vector<ClockTreeNode *> clkpath,
 void ClockTree::dumpClauseToCnfFile(void)
 {
 	//if( !this->_placedcc && !(this->ifdoVTA()) )  return ;
+    if( this->_timingclausenum > this->Max_timing_count ) this->Max_timing_count = (long long int)(this->_timingclausenum) ;
+    //-- The built-in SAT engine takes clauses directly, dump only for debugging --
+    if( !this->_extsat && !this->_printClause ) return ;
 	fstream cnffile ;
 	string cnfinput = this->_outputdir + "cnfinput_" + to_string(this->_tc);
 	if( !isDirectoryExist(this->_outputdir) )
@@ -2856,40 +3405,236 @@ void ClockTree::dumpClauseToCnfFile(void)
 			return;
 		}
 		//--- DCC constraint ---------------------------------
-        for( auto const& clause: this->_dccconstraintlist )     {    cnffile << clause << "\n" ; }
+        for( long loop = 0; loop < this->_dccconstraintlist.size(); loop++ )    cnffile << this->_dccconstraintlist.toString(loop) << "\n" ;
         //--- VTA constraint ---------------------------------
-        for( auto const& clause: this->_VTAconstraintlist )     {    cnffile << clause << "\n" ; }
-		//--- Timing constraint -------------------------------
-        for( auto const& clause: this->_timingconstraintlist )  {    cnffile << clause << "\n" ; }
-		printf( YELLOW"\t[--Clause Count---] " RESET"Timing Constraint = %lu\n", this->_timingconstraintlist.size());
+        for( long loop = 0; loop < this->_VTAconstraintlist.size(); loop++ )    cnffile << this->_VTAconstraintlist.toString(loop) << "\n" ;
+        //--- Latency var definition -------------------------
+        for( long loop = 0; loop < this->_latencydeflist.size(); loop++ )       cnffile << this->_latencydeflist.toString(loop) << "\n" ;
+		//--- Timing constraint (DB prefix of Tc) ------------
+        for( long loop = 0; loop < this->_timingclausenum; loop++ )
+            cnffile << this->_tcclausearena.toString( this->_tcclausedb[loop]._clause ) << "\n" ;
+		printf( YELLOW"\t[--Clause Count---] " RESET"Timing Constraint = %ld\n", this->_timingclausenum );
         cnffile.close();
 	}
-    if( this->_timingconstraintlist.size() > this->Max_timing_count ) this->Max_timing_count = (long long int)(this->_timingconstraintlist.size()) ;
 }
 
 /////////////////////////////////////////////////////////////////////
 //
-// ClockTree Class - Public Method
-// Call MiniSat
+// ClockTree Class - Private Method
+// Load clauses into the in-process SAT solver and return the
+// assumptions selecting the timing clauses of the current Tc.
+// DCC/VTA/DCC-leader constraints are loaded once. Timing clauses of
+// the DB are loaded as bands (index ranges of the DB), each guarded
+// by its own activation var, so one solver (with its learnt clauses
+// and activities) answers every Tc probe: bands above Tc are
+// assumed on, the others off. A band cut by a higher Tc is retired
+// (its var is fixed off, so the solver deletes its clauses at the next
+// solve) and loaded again as two bands.
+// The latest SAT model is given as the phase hint of the next call.
 //
 /////////////////////////////////////////////////////////////////////
-void ClockTree::execMinisat(void)
+vector<int> ClockTree::loadClauseToSolver(void)
 {
-    /*
-    if(!this->_placedcc)
-        return;
-     */
-    // MiniSat input file
-    string cnfinput = this->_outputdir + "cnfinput_" + to_string(this->_tc);
-    // MiniSat output file
-    string cnfoutput = this->_outputdir + "cnfoutput_" + to_string(this->_tc);
-    if(!isDirectoryExist(this->_outputdir))
-        mkdir(this->_outputdir.c_str(), 0775);
-    if(isFileExist(cnfinput))
+    if( !this->_tcdbready || this->_tc < this->_tcdbfloor ) this->buildTimingClauseDB();
+    if( this->_satsolver.empty() || !this->_satsolver[0]->okay() )
     {
-        this->_minisatexecnum++;
-        //string execmd = "minisat " + cnfinput + " " + cnfoutput;
-        //system(execmd.c_str());
+        this->clearSolver();
+        for( int conf = 0; conf < this->_portfolio; conf++ )
+        {
+            SatSolver *solver = new SatSolver() ;
+            solver->setConfig( SatPortfolio[conf]._config );
+            solver->setBudget( this->_satconflictbudget, this->_sattimebudget );
+            solver->reserveVars( (int)this->getCnfVarNumber() );
+            this->_satsolver.push_back( solver );
+        }
+        this->_satloadedrefine = 0 ;
+        this->_satband.clear();
+        this->_satloadednum = 0 ;
+        //--- DCC constraint ---------------------------------
+        for( long loop = 0; loop < this->_dccconstraintlist.size(); loop++ )
+            this->addClauseToSolver( this->_dccconstraintlist.getLiterals(loop), this->_dccconstraintlist.getClauseSize(loop) );
+        //--- VTA/DCC-leader constraint ----------------------
+        for( long loop = 0; loop < this->_VTAconstraintlist.size(); loop++ )
+            this->addClauseToSolver( this->_VTAconstraintlist.getLiterals(loop), this->_VTAconstraintlist.getClauseSize(loop) );
+        //--- Latency var definition ------------------------
+        for( long loop = 0; loop < this->_latencydeflist.size(); loop++ )
+            this->addClauseToSolver( this->_latencydeflist.getLiterals(loop), this->_latencydeflist.getClauseSize(loop) );
+    }
+    //--- Timing constraint (DB prefix of Tc) -------------
+    long prefix = this->getTimingClausePrefix( this->_tc );
+    if( prefix > this->_satloadednum )
+    {
+        this->loadTimingBand( this->_satloadednum, prefix );
+        this->_satloadednum = prefix ;
+    }
+    else
+    {
+        for( long loop = 0; loop < (long)this->_satband.size(); loop++ )
+        {
+            long begin = get<0>(this->_satband[loop]), end = get<1>(this->_satband[loop]) ;
+            if( begin >= prefix || end <= prefix ) continue ;
+            this->addClauseToSolver( { -get<2>(this->_satband[loop]) } );
+            this->_satband.erase( this->_satband.begin() + loop );
+            this->loadTimingBand( begin, prefix );
+            this->loadTimingBand( prefix, end   );
+            break ;
+        }
+    }
+    //--- Refinement (blocking) clauses -------------------
+    for( ; this->_satloadedrefine < this->_refineclauselist.size(); this->_satloadedrefine++ )
+        this->addClauseToSolver( this->_refineclauselist.getLiterals(this->_satloadedrefine), this->_refineclauselist.getClauseSize(this->_satloadedrefine) );
+    this->_satloadedtc = this->_tc ;
+    //--- Warm start ----------------------------------------
+    if( this->_phasehint )
+        for( auto solver: this->_satsolver ) solver->setPhase( this->_phasemodel );
+    
+    vector<int> assumps ;
+    for( auto const& band: this->_satband )
+        assumps.push_back( ( get<1>(band) <= prefix ) ? get<2>(band) : -get<2>(band) );
+    return assumps ;
+}
+
+/////////////////////////////////////////////////////////////////////
+//
+// ClockTree Class - Private Method
+// Load the timing clauses [begin, end) of the DB guarded by a new
+// activation var
+//
+/////////////////////////////////////////////////////////////////////
+void ClockTree::loadTimingBand( long begin, long end )
+{
+    int act = this->newSolverVar() ;
+    vector<int> clause ;
+    for( long loop = begin; loop < end; loop++ )
+    {
+        long idx = this->_tcclausedb[loop]._clause ;
+        clause.assign( 1, -act );
+        clause.insert( clause.end(), this->_tcclausearena.getLiterals(idx), this->_tcclausearena.getLiterals(idx) + this->_tcclausearena.getClauseSize(idx) );
+        this->addClauseToSolver( clause );
+    }
+    this->_satband.push_back( make_tuple( begin, end, act ) );
+}
+
+/////////////////////////////////////////////////////////////////////
+//
+// ClockTree Class - Private Method
+// New var in every solver of the portfolio (the same var in each)
+//
+/////////////////////////////////////////////////////////////////////
+int ClockTree::newSolverVar(void)
+{
+    int var = 0 ;
+    for( auto solver: this->_satsolver ) var = solver->newVar() ;
+    return var ;
+}
+
+/////////////////////////////////////////////////////////////////////
+//
+// ClockTree Class - Private Method
+// Delete the solvers of the SAT engine (and of the probe slots)
+//
+/////////////////////////////////////////////////////////////////////
+void ClockTree::clearSolver(void)
+{
+    for( auto solver: this->_satsolver ) delete solver ;
+    this->_satsolver.clear();
+    this->clearTcProbeSlot();
+}
+
+/////////////////////////////////////////////////////////////////////
+//
+// ClockTree Class - Private Method
+// Add a clause to every solver of the portfolio
+//
+/////////////////////////////////////////////////////////////////////
+void ClockTree::addClauseToSolver( const int *lits, long size )
+{
+    for( auto solver: this->_satsolver ) solver->addClause( lits, size );
+}
+
+/////////////////////////////////////////////////////////////////////
+//
+// ClockTree Class - Private Method
+// Add the DCC/VTA/DCC-leader constraints, the definitions of latency
+// vars and the refinement clauses to a standalone solver
+//
+/////////////////////////////////////////////////////////////////////
+void ClockTree::addConstraintToSolver( SatSolver *solver )
+{
+    for( auto arena: { &this->_dccconstraintlist, &this->_VTAconstraintlist, &this->_latencydeflist, &this->_refineclauselist } )
+        for( long loop = 0; loop < arena->size(); loop++ )
+            solver->addClause( arena->getLiterals(loop), arena->getClauseSize(loop) );
+}
+
+/////////////////////////////////////////////////////////////////////
+//
+// ClockTree Class - Private Method
+// Race the solvers of the portfolio under the same assumptions and
+// take the first definitive answer (the others are interrupted).
+// Return SAT_SAT/SAT_UNSAT, the model of the winner in "model", or
+// SAT_UNKNOWN if all of them run out of budget.
+//
+/////////////////////////////////////////////////////////////////////
+int ClockTree::solveByPortfolio( const vector<int> &assumps, vector<int> &model )
+{
+    vector< int >    results( this->_satsolver.size(), SAT_UNKNOWN );
+    vector< long >   conflicts ;
+    vector< thread > racers ;
+    atomic< int >    winner( -1 );
+    
+    for( auto solver: this->_satsolver ) conflicts.push_back( solver->getConflictNumber() );
+    if( this->_satsolver.size() == 1 )
+    {
+        results[0] = this->_satsolver[0]->solve( assumps );
+        if( results[0] != SAT_UNKNOWN ) winner = 0 ;
+    }
+    else
+    {
+        for( int conf = 0; conf < (int)this->_satsolver.size(); conf++ )
+        {
+            racers.push_back( thread( [ this, conf, &assumps, &results, &winner ]()
+            {
+                results[conf] = this->_satsolver[conf]->solve( assumps );
+                int expected = -1 ;
+                if( results[conf] != SAT_UNKNOWN && winner.compare_exchange_strong( expected, conf ) )
+                    for( int other = 0; other < (int)this->_satsolver.size(); other++ )
+                        if( other != conf ) this->_satsolver[other]->interrupt();
+            } ) );
+        }
+        for( auto &racer: racers ) racer.join();
+        for( auto solver: this->_satsolver ) solver->clearInterrupt();
+    }
+    this->_satwinner = winner ;
+    model.clear();
+    for( int conf = 0; conf < (int)this->_satsolver.size(); conf++ )
+        this->_satconflictnum += this->_satsolver[conf]->getConflictNumber() - conflicts[conf] ;
+    if( this->_satwinner < 0 ) return SAT_UNKNOWN ;//every configuration is out of budget
+    this->_satwincount[this->_satwinner]++ ;
+    model = this->_satsolver[this->_satwinner]->getModel();
+    if( results[this->_satwinner] == SAT_SAT ) this->_phasemodel = model ;
+    return results[this->_satwinner] ;
+}
+
+/////////////////////////////////////////////////////////////////////
+//
+// ClockTree Class - Private Method
+// Fork/exec ./minisat with each configuration of the portfolio on
+// "cnfinput", take the first definitive answer and kill the others.
+// The output of the winner is moved to "cnfoutput".
+// Return SAT_SAT, SAT_UNSAT, SAT_UNKNOWN (out of "-sat_timeout") or
+// -1 (no answer)
+//
+/////////////////////////////////////////////////////////////////////
+int ClockTree::runMinisat( string cnfinput, string cnfoutput, vector<int> &model )
+{
+    map< pid_t, int > children ;//pid -> configuration
+    int status = -1 ;
+    chrono::steady_clock::time_point starttime = chrono::steady_clock::now();
+    model.clear();
+    this->_satwinner = -1 ;
+    for( int conf = 0; conf < this->_portfolio; conf++ )
+    {
+        string output = ( conf == 0 ) ? cnfoutput : cnfoutput + "_" + SatPortfolio[conf]._name ;
         // Fork a process
         pid_t childpid = fork();
         if(childpid == -1)
@@ -2897,7 +3642,7 @@ void ClockTree::execMinisat(void)
         else if(childpid == 0)
         {
             // Child process
-            string minisatfile = this->_outputdir + "minisat_output";
+            string minisatfile = this->_outputdir + "minisat_output" + ( ( conf == 0 ) ? "" : string("_") + SatPortfolio[conf]._name );
             int fp = open(minisatfile.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0664);
             if(fp == -1)
                 cerr << RED"[Error]: Cannot dump the executive output of minisat!\033[0m\n";
@@ -2907,105 +3652,932 @@ void ClockTree::execMinisat(void)
                 dup2(fp, STDERR_FILENO);
                 close(fp);
             }
-            //this->~ClockTree();
-            // Call MiniSat
-            if(execlp("./minisat", "./minisat", cnfinput.c_str(), cnfoutput.c_str(), (char *)0) == -1)
-            {
+            vector< string > opts = stringSplit( SatPortfolio[conf]._minisatopt, " " );
+            vector< char* >  args ;
+            args.push_back( (char *)"./minisat" );
+            for( auto &opt: opts ) args.push_back( (char *)opt.c_str() );
+            args.push_back( (char *)cnfinput.c_str() );
+            args.push_back( (char *)output.c_str() );
+            args.push_back( (char *)0 );
+            if(execvp("./minisat", args.data()) == -1)
                 cerr << RED"[Error]: Cannot execute minisat!\033[0m\n";
-                this->_minisatexecnum--;
-            }
             exit(0);
         }
+        else children[childpid] = conf ;
+    }
+    // Parent process: the first definitive answer wins
+    while( !children.empty() )
+    {
+        int exitstatus;
+        pid_t childpid = waitpid(-1, &exitstatus, ( this->_sattimebudget > 0 && status == -1 ) ? WNOHANG : 0 );
+        if( childpid == -1 ) break ;
+        //-- Out of time budget ----------------------------------------------------------
+        if( childpid == 0 )
+        {
+            if( chrono::duration_cast< chrono::duration<double> >( chrono::steady_clock::now() - starttime ).count() > this->_sattimebudget )
+            {
+                for( auto const& child: children ) kill( child.first, SIGKILL );
+                status = SAT_UNKNOWN ;
+            }
+            else usleep( 1000 );
+            continue ;
+        }
+        map< pid_t, int >::iterator found = children.find(childpid);
+        if( found == children.end() ) continue ;
+        int conf = found->second ;
+        children.erase(found);
+        if( status != -1 ) continue ;
+        
+        string output = ( conf == 0 ) ? cnfoutput : cnfoutput + "_" + SatPortfolio[conf]._name ;
+        status = this->readMinisatOutput( output, model );
+        if( status == -1 ) continue ;
+        if( status == SAT_SAT ) this->_phasemodel = model ;
+        for( auto const& child: children ) kill( child.first, SIGKILL );
+        if( conf != 0 ) rename( output.c_str(), cnfoutput.c_str() );
+        this->_satwinner = conf ;
+        this->_satwincount[conf]++ ;
+    }
+    return status ;
+}
+
+/////////////////////////////////////////////////////////////////////
+//
+// ClockTree Class - Public Method
+// Name of a configuration of the solver portfolio
+//
+/////////////////////////////////////////////////////////////////////
+string ClockTree::getPortfolioName( int conf )
+{
+    return SatPortfolio[conf]._name ;
+}
+
+/////////////////////////////////////////////////////////////////////
+//
+// ClockTree Class - Private Method
+// Number of timing clauses of "tc" (prefix length of the DB)
+//
+/////////////////////////////////////////////////////////////////////
+long ClockTree::getTimingClausePrefix( double tc )
+{
+    long low = 0, up = (long)this->_tcclausedb.size() ;
+    while( low < up )
+    {
+        long mid = ( low + up ) / 2 ;
+        if( this->_tcclausedb[mid]._tcth > tc + TCDB_EPSILON )  low = mid + 1 ;
+        else                                                    up  = mid ;
+    }
+    return low ;
+}
+
+/////////////////////////////////////////////////////////////////////
+//
+// ClockTree Class - Private Method
+// Read the output file of minisat into "model"
+// Return SAT_SAT, SAT_UNSAT, or -1 (file error)
+//
+/////////////////////////////////////////////////////////////////////
+int ClockTree::readMinisatOutput( string cnfoutput, vector<int> &model )
+{
+    fstream cnffile;
+    string  line;
+    model.clear();
+    if( !isFileExist(cnfoutput) )   return -1;
+    cnffile.open(cnfoutput, ios::in);
+    if( !cnffile.is_open() )
+    {
+        cerr << RED"\t[Error]: Cannot open " << cnfoutput << "\033[0m\n";
+        cnffile.close();
+        return -1;
+    }
+    getline(cnffile, line);
+    if((line.size() == 5) && (line.find("UNSAT") != string::npos))
+    {
+        cnffile.close();
+        return SAT_UNSAT;
+    }
+    else if((line.size() == 3) && (line.find("SAT") != string::npos))
+    {
+        getline(cnffile, line);
+        for( auto const& lit: stringSplit(line, " ") )
+        {
+            if( stoi(lit) == 0 ) break;
+            model.push_back( stoi(lit) );
+        }
+        cnffile.close();
+        return SAT_SAT;
+    }
+    cnffile.close();
+    return -1;
+}
+
+/////////////////////////////////////////////////////////////////////
+//
+// ClockTree Class - Public Method
+// Call SAT solver (the built-in engine, or ./minisat with
+// "-sat=minisat") on the clauses of the current Tc
+//
+/////////////////////////////////////////////////////////////////////
+void ClockTree::execMinisat(void)
+{
+    /*
+    if(!this->_placedcc)
+        return;
+     */
+    // MiniSat input file
+    string cnfinput = this->_outputdir + "cnfinput_" + to_string(this->_tc);
+    // MiniSat output file
+    string cnfoutput = this->_outputdir + "cnfoutput_" + to_string(this->_tc);
+    this->_satstatus = -1 ;
+    this->_satmodel.clear();
+    //---- Built-in SAT engine ----------------------------------------------------
+    if( !this->_extsat )
+    {
+        vector<int> assumps = this->loadClauseToSolver();
+        this->_minisatexecnum++;
+        this->_satstatus = this->solveByPortfolio( assumps, this->_satmodel );
+        //-- "-lazy K": solve again until the model meets every timing edge --------
+        while( this->_satstatus == SAT_SAT && this->lazyRefine( this->_satmodel ) )
+        {
+            assumps = this->loadClauseToSolver();
+            this->_minisatexecnum++;
+            this->_satstatus = this->solveByPortfolio( assumps, this->_satmodel );
+        }
+        //-- No winner (-1) if no configuration answers (UNKNOWN) -------------------
+        if( this->_printClause )
+            this->_satsolver[ max( this->_satwinner, 0 ) ]->writeResult( cnfoutput, this->_satstatus );
+        return ;
+    }
+    //---- External minisat ---------------------------------------------------------
+    if(!isDirectoryExist(this->_outputdir))
+        mkdir(this->_outputdir.c_str(), 0775);
+    if(isFileExist(cnfinput))
+    {
+        this->_minisatexecnum++;
+        //string execmd = "minisat " + cnfinput + " " + cnfoutput;
+        //system(execmd.c_str());
+        this->_satstatus = this->runMinisat( cnfinput, cnfoutput, this->_satmodel );
+    }
+}
+
+/////////////////////////////////////////////////////////////////////
+//
+// ClockTree Class - Public Method
+// Change the boundary of Binary search and search for the optimal Tc
+//
+/////////////////////////////////////////////////////////////////////
+bool ClockTree::tcBinarySearch( )
+//void ClockTree::tcBinarySearch(double slack)
+{
+    // Place DCCs
+    if( this->_placedcc || this->ifdoVTA() )
+    {
+        // Change the lower boundary (conservatively if out of budget)
+        if( this->_satstatus == SAT_UNSAT || this->_satstatus == SAT_UNKNOWN )
+        {
+            if( this->_satstatus == SAT_UNSAT ) this->_tcprovenlow = max( this->_tcprovenlow, this->_tc );
+            else                                this->_tcunknownnum++ ;
+            this->_tclowbound = this->_tc;
+            if( this->_tcdiscrete ) return this->tcDiscreteSearch();
+            this->_tc = ceilNPrecision((this->_tcupbound + this->_tclowbound) / 2, PRECISION);
+            if( this->_satstatus == SAT_UNSAT ) printf( YELLOW"\t[----MiniSAT------] " RESET "Return: " RED"UNSAT \033[0m\n" ) ;
+            else                                printf( YELLOW"\t[----MiniSAT------] " RESET "Return: " MAGENTA"UNKNOWN (out of budget) \033[0m\n" ) ;
+            printf( YELLOW"\t[--Binary Search--] " RESET "Next Tc range: %f - %f \033[0m\n", _tclowbound, _tcupbound ) ;
+            return false;
+        }
+        // Change the upper boundary
+        else if( this->_satstatus == SAT_SAT )
+        {
+            this->_besttc = this->_tc;
+            this->_bestmodel = this->_satmodel;
+            this->_tcupbound = this->_tc;
+            if( this->_tcdiscrete ) return this->tcDiscreteSearch();
+            this->_tc = floorNPrecision((this->_tcupbound + this->_tclowbound) / 2, PRECISION);
+            printf( YELLOW"\t[----MiniSAT------] " RESET "Return: " GREEN"SAT \033[0m\n" ) ;
+            printf( YELLOW"\t[--Binary Search--] " RESET"Next Tc range: %f - %f \033[0m\n", _tclowbound, _tcupbound ) ;
+            return true;
+        }
+    }
+    else
+    {
+        double minslack = this->sweepPathTiming( false, true, true );
+        // Change the lower boundary
+        if( minslack <= 0)
+        {
+            this->_tclowbound = this->_tc;
+            this->_tc = ceilNPrecision((this->_tcupbound + this->_tclowbound) / 2, PRECISION);
+            printf( YELLOW"\t[Slack] " RESET "slack = " RED"%f \033[0m\n", minslack ) ;
+            printf( YELLOW"\t[Binary Search] " RESET"Next Tc range: %f - %f \033[0m\n", _tclowbound, _tcupbound ) ;
+        }
+        // Change the upper boundary
+        else if( minslack > 0)
+        {
+            this->_besttc = this->_tc;
+            this->_tcupbound = this->_tc;
+            this->_tc = floorNPrecision((this->_tcupbound + this->_tclowbound) / 2, PRECISION);
+            printf( YELLOW"\t[Slack] " RESET "slack = " GREEN"%f \033[0m\n", minslack ) ;
+            printf( YELLOW"\t[Binary Search] " RESET"Next Tc range: %f - %f \033[0m\n", _tclowbound, _tcupbound ) ;
+        }
+    }
+    return false;
+}
+
+
+/////////////////////////////////////////////////////////////////////
+//
+// ClockTree Class - Public Method
+// Collect the candidates of the discrete Tc search. The timing
+// clauses only change when Tc crosses a critical Tc, so the optimal
+// Tc is either the floor of the DB or one of the critical Tc.
+//
+/////////////////////////////////////////////////////////////////////
+void ClockTree::initTcCandidate(void)
+{
+    if( !this->_tcdiscrete || ( this->_placedcc == false && this->ifdoVTA() == false ) ) return ;
+    if( !this->_tcdbready || this->_tc < this->_tcdbfloor ) this->buildTimingClauseDB();
+    
+    this->_tccandidate.clear();
+    this->_tccandidate.push_back( this->_tcdbfloor );
+    //-- DB is sorted in descending order --------------------------------------------------
+    for( long loop = (long)this->_tcclausedb.size() - 1; loop >= 0; loop-- )
+    {
+        double tcth = this->_tcclausedb[loop]._tcth ;
+        if( tcth > this->_tcupbound + TCDB_EPSILON ) break ;
+        if( tcth > this->_tccandidate.back() + TCDB_EPSILON ) this->_tccandidate.push_back( tcth );
+    }
+    this->_tccandlow    = -1 ;
+    this->_tccandup     = (long)this->_tccandidate.size() ;
+    this->_tccandidx    = ( this->_tccandlow + this->_tccandup ) / 2 ;
+    this->_tcsearchdone = false ;
+    this->_tc = this->_tccandidate[this->_tccandidx] ;
+    printf( YELLOW"\t[--Discrete Search] " RESET"%ld candidates of Tc in %f - %f \033[0m\n", this->_tccandup, this->_tcdbfloor, this->_tcupbound ) ;
+}
+
+/////////////////////////////////////////////////////////////////////
+//
+// ClockTree Class - Public Method
+// If every probe within the budget ("-sat_conflicts"/"-sat_timeout")
+// failed to prove a Tc SAT, solve the upper bound of Tc without
+// budget, so that a proven Tc and its deployment can be reported
+//
+/////////////////////////////////////////////////////////////////////
+void ClockTree::tcAnytimeFallback(void)
+{
+    if( !this->_bestmodel.empty() || !this->ifSatBudget() ) return ;
+    if( this->_placedcc == false && this->ifdoVTA() == false ) return ;
+    
+    long   conflictbudget = this->_satconflictbudget ;
+    double timebudget     = this->_sattimebudget ;
+    this->_satconflictbudget = -1 ;
+    this->_sattimebudget     = 0 ;
+    for( auto solver: this->_satsolver ) solver->setBudget( -1, 0 );
+    
+    this->_tc = this->_tcupbound ;
+    printf( YELLOW"\t[--Anytime Result-] " RESET"No Tc proven SAT within budget, solving Tc = %f without budget \033[0m\n", this->_tc ) ;
+    this->timingConstraint();
+    this->dumpClauseToCnfFile();
+    this->execMinisat();
+    if( this->_satstatus == SAT_SAT )
+    {
+        this->_besttc    = this->_tc ;
+        this->_bestmodel = this->_satmodel ;
+    }
+    
+    this->_satconflictbudget = conflictbudget ;
+    this->_sattimebudget     = timebudget ;
+    for( auto solver: this->_satsolver ) solver->setBudget( conflictbudget, timebudget );
+}
+
+/////////////////////////////////////////////////////////////////////
+//
+// ClockTree Class - Public Method
+// Explain the largest Tc proven UNSAT ("-unsat_core"): its timing
+// clauses are guarded by one selector var per critical path and
+// solved under all selectors; the selectors of the final conflict
+// are the paths that cannot meet Tc together. The core is trimmed
+// by solving again under its own selectors until it stops shrinking
+// (small, but not necessarily minimal).
+// Return true if a core is found
+//
+/////////////////////////////////////////////////////////////////////
+bool ClockTree::extractUnsatCore(void)
+{
+    this->_unsatcore.clear();
+    this->_unsatcoretc = -1 ;
+    if( !this->_unsatcoreon || this->_tcprovenlow < 0 ) return false ;
+    if( this->_placedcc == false && this->ifdoVTA() == false ) return false ;
+    if( !this->_tcdbready || this->_tcprovenlow < this->_tcdbfloor ) this->buildTimingClauseDB();
+    
+    SatSolver     solver ;
+    map< long, int > selector ;//path number -> selector var
+    solver.setBudget( this->_satconflictbudget, this->_sattimebudget );
+    solver.reserveVars( (int)this->getCnfVarNumber() );
+    this->addConstraintToSolver( &solver );
+    long prefix = this->getTimingClausePrefix( this->_tcprovenlow );
+    for( long loop = 0; loop < prefix; loop++ )
+    {
+        map< long, int >::iterator found = selector.find( this->_tcclausedb[loop]._pathnum );
+        if( found == selector.end() )
+            found = selector.insert( pair< long, int >( this->_tcclausedb[loop]._pathnum, solver.newVar() ) ).first ;
+        vector<int> clause = this->_tcclausearena.getClause( this->_tcclausedb[loop]._clause );
+        clause.insert( clause.begin(), -found->second );
+        solver.addClause( clause );
+    }
+    
+    //-- Solve under all selectors, then trim ---------------------------------------
+    vector< int > assumps ;
+    for( auto const& sel: selector ) assumps.push_back( sel.second );
+    while( true )
+    {
+        if( solver.solve( assumps ) != SAT_UNSAT )
+        {
+            printf( YELLOW"	[--UNSAT Core-----] " RESET"Tc = %f is not proven UNSAT again (no core)\n", this->_tcprovenlow );
+            return false ;
+        }
+        vector< int > core ;
+        for( auto lit: solver.getConflict() ) core.push_back( abs(lit) );
+        sort( core.begin(), core.end() );
+        if( core.size() >= assumps.size() ) break ;
+        assumps = core ;
+    }
+    for( auto const& sel: selector )
+        if( binary_search( assumps.begin(), assumps.end(), sel.second ) ) this->_unsatcore.push_back( sel.first );
+    this->_unsatcoretc = this->_tcprovenlow ;
+    printf( YELLOW"	[--UNSAT Core-----] " RESET"%lu of %lu critical paths pin Tc = %f\n", this->_unsatcore.size(), selector.size(), this->_unsatcoretc );
+    return true ;
+}
+
+/////////////////////////////////////////////////////////////////////
+//
+// ClockTree Class - Private Method
+// Bisect over the index of the Tc candidates (called by
+// tcBinarySearch after the SAT result of the current candidate)
+//
+/////////////////////////////////////////////////////////////////////
+bool ClockTree::tcDiscreteSearch(void)
+{
+    bool sat = ( this->_satstatus == SAT_SAT );
+    if( sat )   this->_tccandup  = this->_tccandidx ;
+    else        this->_tccandlow = this->_tccandidx ;
+    
+    if( this->_tccandup - this->_tccandlow > 1 )
+    {
+        this->_tccandidx = ( this->_tccandlow + this->_tccandup ) / 2 ;
+        this->_tc = this->_tccandidate[this->_tccandidx] ;
+    }
+    else
+    {
+        //-- Converge: smallest SAT candidate ---------------------------------------------
+        this->_tcsearchdone = true ;
+        if( this->_tccandup < (long)this->_tccandidate.size() ) this->_tc = this->_tccandidate[this->_tccandup] ;
+    }
+    if( sat )                                   printf( YELLOW"\t[----MiniSAT------] " RESET "Return: " GREEN"SAT \033[0m\n" ) ;
+    else if( this->_satstatus == SAT_UNKNOWN )  printf( YELLOW"\t[----MiniSAT------] " RESET "Return: " MAGENTA"UNKNOWN (out of budget) \033[0m\n" ) ;
+    else                                        printf( YELLOW"\t[----MiniSAT------] " RESET "Return: " RED"UNSAT \033[0m\n" ) ;
+    if( this->_tcsearchdone )
+        printf( YELLOW"\t[--Discrete Search] " RESET"Converged at candidate %ld of %ld \033[0m\n", this->_tccandup, (long)this->_tccandidate.size() ) ;
+    else
+        printf( YELLOW"\t[--Discrete Search] " RESET"Next candidate %ld (%ld - %ld), Tc = %.9f \033[0m\n", this->_tccandidx, this->_tccandlow, this->_tccandup, this->_tc ) ;
+    return sat ;
+}
+
+/////////////////////////////////////////////////////////////////////
+//
+// ClockTree Class - Private Method
+// Probe points of the next round of the k-section search: "_jobs"
+// points splitting the Tc range (or the candidate index range of
+// the discrete search) into "_jobs"+1 sections
+//
+/////////////////////////////////////////////////////////////////////
+void ClockTree::genTcProbe(void)
+{
+    this->_tcprobe.clear();
+    for( int loop = 1; loop <= this->_jobs; loop++ )
+    {
+        TC_PROBE probe ;
+        probe._clausenum = 0 ; probe._status = -1 ; probe._time = 0 ; probe._conflicts = 0 ; probe._cancelled = false ;
+        if( this->_tcdiscrete )
+        {
+            probe._candidx = this->_tccandlow + ( loop * ( this->_tccandup - this->_tccandlow ) ) / ( this->_jobs + 1 ) ;
+            if( probe._candidx <= this->_tccandlow || probe._candidx >= this->_tccandup ) continue ;
+            if( !this->_tcprobe.empty() && this->_tcprobe.back()._candidx == probe._candidx ) continue ;
+            probe._tc = this->_tccandidate[probe._candidx] ;
+        }
+        else
+        {
+            probe._candidx = -1 ;
+            probe._tc = floorNPrecision( this->_tclowbound + loop * ( this->_tcupbound - this->_tclowbound ) / ( this->_jobs + 1 ), PRECISION );
+            if( probe._tc <= this->_tclowbound + pow( 10, -PRECISION ) / 2 || probe._tc >= this->_tcupbound - pow( 10, -PRECISION ) / 2 ) continue ;
+            if( !this->_tcprobe.empty() && this->_tcprobe.back()._tc == probe._tc ) continue ;
+        }
+        this->_tcprobe.push_back( probe );
+    }
+}
+
+/////////////////////////////////////////////////////////////////////
+//
+// ClockTree Class - Private Method
+// Load clauses into the solver of a probe slot and return the
+// assumptions selecting the first "prefix" timing clauses of the DB.
+// Same scheme as loadClauseToSolver: a slot keeps its solver for the
+// whole k-section search, timing clauses are loaded as bands guarded
+// by activation vars (see loadSlotTimingClause).
+//
+/////////////////////////////////////////////////////////////////////
+vector<int> ClockTree::loadTcProbeSlot( TC_PROBE_SLOT &slot, long prefix )
+{
+    if( !slot._loaded )
+    {
+        slot._solver->reserveVars( (int)this->getCnfVarNumber() );
+        //--- DCC/VTA/DCC-leader constraint, refinement clauses (fixed during the search)
+        this->addConstraintToSolver( slot._solver );
+        slot._loaded = true ;
+    }
+    return this->loadSlotTimingClause( slot, prefix, this->getTimingClausePrefix( this->_tcupbound ), this->getTimingClausePrefix( this->_tclowbound ),
+                                       [this]( long pos, vector<int> &clause )
+                                       {
+                                           long idx = this->_tcclausedb[pos]._clause ;
+                                           clause.insert( clause.end(), this->_tcclausearena.getLiterals(idx), this->_tcclausearena.getLiterals(idx) + this->_tcclausearena.getClauseSize(idx) );
+                                       } );
+}
+
+/////////////////////////////////////////////////////////////////////
+//
+// ClockTree Class - Private Method
+// Load the first "prefix" timing clauses (clause i appended by
+// "getclause") into the solver of a slot and return the assumptions
+// selecting them. Timing clauses are loaded as bands guarded by
+// activation vars, and a band cut by the prefix is retired and
+// loaded again as two bands. Every later prefix lies in [upprefix,
+// lowprefix] (the Tc range), so the bands out of it are fixed on or
+// off for good.
+//
+/////////////////////////////////////////////////////////////////////
+vector<int> ClockTree::loadSlotTimingClause( TC_PROBE_SLOT &slot, long prefix, long upprefix, long lowprefix, const function< void( long, vector<int>& ) > &getclause )
+{
+    //--- Every later probe lies inside the Tc range: the clauses above its upper bound
+    //--- stay on (no guard) and the bands below its lower bound stay off (retired) ---
+    for( long loop = 0; loop < (long)slot._band.size(); loop++ )
+    {
+        int act = get<2>(slot._band[loop]) ;
+        if( get<1>(slot._band[loop]) <= upprefix )          slot._solver->addClause( vector<int>{  act } );
+        else if( get<0>(slot._band[loop]) >= lowprefix )    slot._solver->addClause( vector<int>{ -act } );
+        else continue ;
+        slot._band.erase( slot._band.begin() + loop-- );
+    }
+    //--- Timing constraint (prefix of Tc) ----------------
+    vector<int> clause ;
+    auto loadband = [&]( long begin, long end )
+    {
+        int act = slot._solver->newVar() ;
+        for( long loop = begin; loop < end; loop++ )
+        {
+            clause.assign( 1, -act );
+            getclause( loop, clause );
+            slot._solver->addClause( clause );
+        }
+        slot._band.push_back( make_tuple( begin, end, act ) );
+    };
+    if( prefix > slot._loadednum )
+    {
+        for( ; slot._loadednum < min( upprefix, prefix ); slot._loadednum++ )
+        {
+            clause.clear();
+            getclause( slot._loadednum, clause );
+            slot._solver->addClause( clause );
+        }
+        if( prefix > slot._loadednum ) loadband( slot._loadednum, prefix );
+        slot._loadednum = prefix ;
+    }
+    else
+    {
+        for( long loop = 0; loop < (long)slot._band.size(); loop++ )
+        {
+            long begin = get<0>(slot._band[loop]), end = get<1>(slot._band[loop]) ;
+            if( begin >= prefix || end <= prefix ) continue ;
+            slot._solver->addClause( vector<int>{ -get<2>(slot._band[loop]) } );
+            slot._band.erase( slot._band.begin() + loop );
+            loadband( begin, prefix );
+            if( prefix < lowprefix ) loadband( prefix, min( end, lowprefix ) );
+            break ;
+        }
+    }
+    
+    vector<int> assumps ;
+    for( auto const& band: slot._band )
+        assumps.push_back( ( get<1>(band) <= prefix ) ? get<2>(band) : -get<2>(band) );
+    return assumps ;
+}
+
+/////////////////////////////////////////////////////////////////////
+//
+// ClockTree Class - Private Method
+// Delete the solvers of the probe slots (their bands refer to the
+// current timing clause DB)
+//
+/////////////////////////////////////////////////////////////////////
+void ClockTree::clearTcProbeSlot(void)
+{
+    for( auto &slot: this->_tcprobeslot ) delete slot._solver ;
+    this->_tcprobeslot.clear();
+}
+
+/////////////////////////////////////////////////////////////////////
+//
+// ClockTree Class - Private Method
+// Solve one probe of the k-section search in the solver of its slot
+// (run by a thread of execMinisatParallel). Once it is decided, the
+// probes it makes moot (higher Tc of a SAT, lower Tc of an UNSAT)
+// are cancelled.
+//
+/////////////////////////////////////////////////////////////////////
+void ClockTree::solveTcProbe( long idx, mutex &mtx )
+{
+    chrono::steady_clock::time_point starttime = chrono::steady_clock::now();
+    TC_PROBE      &probe = this->_tcprobe[idx] ;
+    TC_PROBE_SLOT &slot  = this->_tcprobeslot[idx] ;
+    
+    slot._solver->setBudget( this->_satconflictbudget, this->_sattimebudget );
+    probe._clausenum = this->getTimingClausePrefix( probe._tc );
+    vector<int> assumps = this->loadTcProbeSlot( slot, probe._clausenum );
+    if( this->_phasehint ) slot._solver->setPhase( this->_phasemodel );
+    long conflicts   = slot._solver->getConflictNumber();
+    probe._status    = slot._solver->solve( assumps );
+    probe._conflicts = slot._solver->getConflictNumber() - conflicts ;
+    if( probe._status == SAT_SAT ) probe._model = slot._solver->getModel();
+    probe._time = chrono::duration_cast< chrono::duration<double> >( chrono::steady_clock::now() - starttime ).count();
+    
+    //-- Cancel the moot probes -------------------------------------------------------
+    if( probe._status == SAT_UNKNOWN ) return ;
+    lock_guard< mutex > lock( mtx );
+    for( long loop = 0; loop < (long)this->_tcprobe.size(); loop++ )
+    {
+        if( ( probe._status == SAT_SAT   && this->_tcprobe[loop]._tc > probe._tc ) ||
+            ( probe._status == SAT_UNSAT && this->_tcprobe[loop]._tc < probe._tc ) )
+        {
+            this->_tcprobe[loop]._cancelled = true ;
+            this->_tcprobeslot[loop]._solver->interrupt();
+        }
+    }
+}
+
+/////////////////////////////////////////////////////////////////////
+//
+// ClockTree Class - Public Method
+// One round of the parallel k-section search: solve all probe
+// points concurrently in independent solvers ("-jobs N")
+//
+/////////////////////////////////////////////////////////////////////
+void ClockTree::execMinisatParallel(void)
+{
+    if( !this->_tcdbready || this->_tclowbound < this->_tcdbfloor )
+    {
+        chrono::steady_clock::time_point starttime = chrono::steady_clock::now();
+        this->buildTimingClauseDB();
+        this->_tcdbtime += chrono::duration_cast< chrono::duration<double> >( chrono::steady_clock::now() - starttime ).count();
+    }
+    this->genTcProbe();
+    
+    //-- Probe i of every round is solved by slot i --------------------------------------
+    vector< thread >     workers ;
+    mutex                mtx ;
+    while( this->_tcprobeslot.size() < this->_tcprobe.size() )
+    {
+        TC_PROBE_SLOT slot ;
+        slot._solver = new SatSolver() ; slot._loaded = false ; slot._loadednum = 0 ;
+        this->_tcprobeslot.push_back( slot );
+    }
+    for( long loop = 0; loop < (long)this->_tcprobe.size(); loop++ )
+        workers.push_back( thread( &ClockTree::solveTcProbe, this, loop, ref(mtx) ) );
+    for( auto &worker: workers ) worker.join();
+    for( auto &slot: this->_tcprobeslot ) slot._solver->clearInterrupt();
+    for( auto const& probe: this->_tcprobe )
+    {
+        this->_satconflictnum += probe._conflicts ;
+        if( probe._clausenum > this->Max_timing_count ) this->Max_timing_count = (long long int)(probe._clausenum) ;
+    }
+    this->_minisatexecnum += (int)this->_tcprobe.size();
+}
+
+/////////////////////////////////////////////////////////////////////
+//
+// ClockTree Class - Public Method
+// Narrow the Tc range to the section bracketing the optimal Tc
+// Return true if the search converges
+//
+/////////////////////////////////////////////////////////////////////
+bool ClockTree::tcKSectionSearch(void)
+{
+    if( this->_tcprobe.empty() )
+    {
+        this->_tcsearchdone = true ;
+        if( this->_besttc != 0 ) this->_tc = this->_besttc ;
+        return true ;
+    }
+    //-- Probes are in ascending Tc and lie inside the range; only the ones above a SAT
+    //-- or below an UNSAT can be cancelled. Out of budget raises the lower bound ------
+    for( auto const& probe: this->_tcprobe )
+    {
+        //-- Largest UNSAT (or UNKNOWN) Tc ---------------------------------------------------
+        if( probe._status == SAT_UNSAT || probe._status == SAT_UNKNOWN )
+        {
+            this->_tclowbound = probe._tc ;
+            if( this->_tcdiscrete ) this->_tccandlow = probe._candidx ;
+            if( probe._status == SAT_UNSAT )    this->_tcprovenlow = max( this->_tcprovenlow, probe._tc );
+            else if( !probe._cancelled )        this->_tcunknownnum++ ;
+        }
+        //-- Smallest SAT Tc -------------------------------------------------------------
+        else if( probe._status == SAT_SAT )
+        {
+            this->_tcupbound = probe._tc ;
+            this->_besttc     = probe._tc ;
+            this->_bestmodel  = probe._model ;
+            this->_phasemodel = probe._model ;
+            if( this->_tcdiscrete ) this->_tccandup = probe._candidx ;
+            break ;
+        }
+    }
+    this->_tc = ( this->_besttc != 0 ) ? this->_besttc : this->_tcupbound ;
+    printf( YELLOW"\t[--k-Section------] " RESET"Next Tc range: %f - %f \033[0m\n", this->_tclowbound, this->_tcupbound ) ;
+    return false ;
+}
+
+/////////////////////////////////////////////////////////////////////
+//
+// ClockTree Class - Private Method
+// Split the CNF (constraints, definitions of latency vars, refinement
+// clauses and the timing clause DB) into components sharing no var
+// (union-find over the vars of each clause). Clock nodes of disjoint
+// subtrees without paths across them end up in different components.
+// The vars of a component are renumbered 1..n for its own solver.
+//
+/////////////////////////////////////////////////////////////////////
+void ClockTree::buildTcComponent(void)
+{
+    long varnum = this->getCnfVarNumber();
+    vector< long > parent( varnum + 1 );
+    for( long var = 0; var <= varnum; var++ ) parent[var] = var ;
+    auto root = [&]( long var ){ while( parent[var] != var ) { parent[var] = parent[parent[var]] ; var = parent[var] ; } return var ; };
+    auto unite = [&]( const int *lits, long size )
+    {
+        for( long loop = 1; loop < size; loop++ ) parent[ root( abs(lits[loop]) ) ] = root( abs(lits[0]) );
+    };
+    vector< ClauseArena* > constraint = { &this->_dccconstraintlist, &this->_VTAconstraintlist, &this->_latencydeflist, &this->_refineclauselist };
+    vector< bool > used( varnum + 1, false );
+    for( auto list: constraint )
+        for( long idx = 0; idx < list->size(); idx++ )
+        {
+            unite( list->getLiterals(idx), list->getClauseSize(idx) );
+            for( long loop = 0; loop < list->getClauseSize(idx); loop++ ) used[ abs( list->getLiterals(idx)[loop] ) ] = true ;
+        }
+    for( auto const& entry: this->_tcclausedb )
+    {
+        unite( this->_tcclausearena.getLiterals( entry._clause ), this->_tcclausearena.getClauseSize( entry._clause ) );
+        for( long loop = 0; loop < this->_tcclausearena.getClauseSize( entry._clause ); loop++ ) used[ abs( this->_tcclausearena.getLiterals( entry._clause )[loop] ) ] = true ;
+    }
+    
+    //-- Components (by their root var) ------------------------------------------------
+    map< long, long > compidx ;
+    this->_component.clear();
+    for( long var = 1; var <= varnum; var++ )
+    {
+        if( !used[var] ) continue ;
+        long rootvar = root( var );
+        if( compidx.count( rootvar ) == 0 )
+        {
+            compidx[rootvar] = (long)this->_component.size() ;
+            this->_component.push_back( TC_COMPONENT() );
+        }
+        this->_component[ compidx[rootvar] ]._var.push_back( (int)var );
+    }
+    vector< int > clause ;
+    for( auto list: constraint )
+        for( long idx = 0; idx < list->size(); idx++ )
+        {
+            TC_COMPONENT &comp = this->_component[ compidx[ root( abs( list->getLiterals(idx)[0] ) ) ] ] ;
+            clause.clear();
+            this->getComponentClause( comp, list->getLiterals(idx), list->getClauseSize(idx), clause );
+            comp._constraint.insert( clause );
+        }
+    long emptynum = 0 ;
+    for( long loop = 0; loop < (long)this->_tcclausedb.size(); loop++ )
+    {
+        long idx = this->_tcclausedb[loop]._clause ;
+        if( this->_tcclausearena.getClauseSize(idx) == 0 ) { emptynum++ ; continue ; }
+        this->_component[ compidx[ root( abs( this->_tcclausearena.getLiterals(idx)[0] ) ) ] ]._timing.push_back( loop );
+    }
+    //-- An empty timing clause (no DCC/VTA can fix the path) goes with the first
+    //-- component; the largest components are searched first -------------------------
+    if( this->_component.empty() ) this->_component.push_back( TC_COMPONENT() );
+    if( emptynum > 0 )
+    {
+        for( long loop = 0; loop < (long)this->_tcclausedb.size(); loop++ )
+            if( this->_tcclausearena.getClauseSize( this->_tcclausedb[loop]._clause ) == 0 ) this->_component[0]._timing.push_back( loop );
+        sort( this->_component[0]._timing.begin(), this->_component[0]._timing.end() );
+    }
+    stable_sort( this->_component.begin(), this->_component.end(),
+                 []( const TC_COMPONENT &a, const TC_COMPONENT &b ){ return a._timing.size() > b._timing.size(); } );
+}
+
+/////////////////////////////////////////////////////////////////////
+//
+// ClockTree Class - Private Method
+// Append a clause to "clause" with the vars of the solver of a
+// component (var i of the solver is comp._var[i-1])
+//
+/////////////////////////////////////////////////////////////////////
+void ClockTree::getComponentClause( const TC_COMPONENT &comp, const int *lits, long size, vector<int> &clause )
+{
+    for( long loop = 0; loop < size; loop++ )
+    {
+        int var = (int)( lower_bound( comp._var.begin(), comp._var.end(), abs( lits[loop] ) ) - comp._var.begin() ) + 1 ;
+        clause.push_back( ( lits[loop] > 0 ) ? var : -var );
+    }
+}
+
+/////////////////////////////////////////////////////////////////////
+//
+// ClockTree Class - Private Method
+// Binary search for the optimal Tc of one component, with the same
+// Tc range, midpoints and stop condition as the search of main(), so
+// that the largest result of the components is the result of the
+// search on the whole CNF. The component keeps one solver for the
+// whole search (its constraints and its timing clauses as bands
+// guarded by activation vars, see loadSlotTimingClause). Other than
+// the first one, a component without timing clauses is solved once.
+//
+/////////////////////////////////////////////////////////////////////
+void ClockTree::searchTcComponent( TC_COMPONENT &comp )
+{
+    chrono::steady_clock::time_point starttime = chrono::steady_clock::now();
+    bool   once = comp._timing.empty() && &comp != &this->_component.front() ;
+    double tc = this->_tc, pretc = 0, prepretc = 0 ;
+    comp._besttc = 0 ; comp._provenlow = -1 ; comp._probenum = 0 ; comp._conflicts = 0 ; comp._clausenum = 0 ;
+    comp._upbound = this->_tcupbound ; comp._lowbound = this->_tclowbound ;
+    
+    //-- Solver of the component ----------------------------------------------------------
+    SatSolver     solver ;
+    TC_PROBE_SLOT slot ;
+    slot._solver = &solver ; slot._loaded = true ; slot._loadednum = 0 ;
+    solver.setBudget( this->_satconflictbudget, this->_sattimebudget );
+    solver.reserveVars( (int)comp._var.size() );
+    for( long idx = 0; idx < comp._constraint.size(); idx++ )
+        solver.addClause( comp._constraint.getLiterals(idx), comp._constraint.getClauseSize(idx) );
+    auto getprefix = [&]( double tcth )
+    {
+        return (long)( partition_point( comp._timing.begin(), comp._timing.end(),
+                                        [&]( long pos ){ return this->_tcclausedb[pos]._tcth > tcth + TCDB_EPSILON ; } ) - comp._timing.begin() );
+    };
+    auto getclause = [&]( long pos, vector<int> &clause )
+    {
+        long idx = this->_tcclausedb[ comp._timing[pos] ]._clause ;
+        this->getComponentClause( comp, this->_tcclausearena.getLiterals(idx), this->_tcclausearena.getClauseSize(idx), clause );
+    };
+    while( true )
+    {
+        prepretc = pretc ; pretc = tc ;
+        long clausenum = getprefix( tc );
+        vector<int> assumps = this->loadSlotTimingClause( slot, clausenum, getprefix( comp._upbound ), getprefix( comp._lowbound ), getclause );
+        comp._clausenum = max( comp._clausenum, clausenum );
+        long conflicts = solver.getConflictNumber();
+        int  status    = solver.solve( assumps );
+        comp._probenum++ ;
+        comp._conflicts += solver.getConflictNumber() - conflicts ;
+        if( status == SAT_SAT )
+        {
+            comp._besttc = tc ;
+            comp._model  = solver.getModel();
+            if( once ) break ;
+            comp._upbound = tc ;
+            tc = floorNPrecision( ( comp._upbound + comp._lowbound ) / 2, PRECISION );
+        }
         else
         {
-            // Parent process
-            int exitstatus;
-            waitpid(childpid, &exitstatus, 0);
+            if( status == SAT_UNSAT ) comp._provenlow = max( comp._provenlow, tc );
+            if( once ) break ;
+            comp._lowbound = tc ;
+            tc = ceilNPrecision( ( comp._upbound + comp._lowbound ) / 2, PRECISION );
         }
+        if( prepretc == tc ) break ;
     }
+    comp._time = chrono::duration_cast< chrono::duration<double> >( chrono::steady_clock::now() - starttime ).count();
+}
+
+/////////////////////////////////////////////////////////////////////
+//
+// ClockTree Class - Private Method
+// Worker of "-components N": search the next free component until
+// no component is left
+//
+/////////////////////////////////////////////////////////////////////
+void ClockTree::searchTcComponentByThread( atomic<long> &nextcomp )
+{
+    for( long idx = nextcomp++; idx < (long)this->_component.size(); idx = nextcomp++ )
+        this->searchTcComponent( this->_component[idx] );
 }
 
 /////////////////////////////////////////////////////////////////////
 //
 // ClockTree Class - Public Method
-// Change the boundary of Binary search and search for the optimal Tc
+// Search the optimal Tc of every independent component concurrently
+// ("-components N"). The optimal Tc is the largest one of the
+// components, and the deployment merges the models of the components
+// (each is valid at a higher Tc, whose timing clauses are a subset).
+// If a component has no Tc proven SAT, no model is kept (see
+// tcAnytimeFallback).
 //
 /////////////////////////////////////////////////////////////////////
-bool ClockTree::tcBinarySearch( )
-//void ClockTree::tcBinarySearch(double slack)
+void ClockTree::execMinisatByComponent(void)
 {
-    // Place DCCs
-    if( this->_placedcc || this->ifdoVTA() )
+    if( this->_placedcc == false && this->ifdoVTA() == false ) return ;
+    chrono::steady_clock::time_point starttime = chrono::steady_clock::now();
+    if( !this->_tcdbready || this->_tclowbound < this->_tcdbfloor ) this->buildTimingClauseDB();
+    this->buildTcComponent();
+    this->_tcdbtime += chrono::duration_cast< chrono::duration<double> >( chrono::steady_clock::now() - starttime ).count();
+    
+    vector< thread > workers ;
+    atomic< long >   nextcomp( 0 );
+    for( int loop = 0; loop < min( (long)this->_compjobs, (long)this->_component.size() ); loop++ )
+        workers.push_back( thread( &ClockTree::searchTcComponentByThread, this, ref(nextcomp) ) );
+    for( auto &worker: workers ) worker.join();
+    
+    //-- Merge the components ------------------------------------------------------------
+    double tc = -1, lowbound = this->_tclowbound ;
+    bool   proven = true ;
+    long   critical = -1 ;
+    long long int clausenum = 0 ;
+    vector< int > model ;
+    for( long var = 1; var <= this->getCnfVarNumber(); var++ ) model.push_back( -(int)var );
+    for( long loop = 0; loop < (long)this->_component.size(); loop++ )
     {
-        fstream cnffile;
-        string line, cnfoutput = this->_outputdir + "cnfoutput_" + to_string(this->_tc);//Minisat results
-        if( !isFileExist(cnfoutput) )   return false;
-        cnffile.open(cnfoutput, ios::in);
-        if( !cnffile.is_open() )
-        {
-            cerr << RED"\t[Error]: Cannot open " << cnfoutput << "\033[0m\n";
-            cnffile.close();
-            return false ;
-        }
-        getline(cnffile, line);
-        // Change the lower boundary
-        if((line.size() == 5) && (line.find("UNSAT") != string::npos))
-        {
-            this->_tclowbound = this->_tc;
-            this->_tc = ceilNPrecision((this->_tcupbound + this->_tclowbound) / 2, PRECISION);
-            printf( YELLOW"\t[----MiniSAT------] " RESET "Return: " RED"UNSAT \033[0m\n" ) ;
-            printf( YELLOW"\t[--Binary Search--] " RESET "Next Tc range: %f - %f \033[0m\n", _tclowbound, _tcupbound ) ;
-            return false;
-        }
-        // Change the upper boundary
-        else if((line.size() == 3) && (line.find("SAT") != string::npos))
-        {
-            this->_besttc = this->_tc;
-            this->_tcupbound = this->_tc;
-            this->_tc = floorNPrecision((this->_tcupbound + this->_tclowbound) / 2, PRECISION);
-            printf( YELLOW"\t[----MiniSAT------] " RESET "Return: " GREEN"SAT \033[0m\n" ) ;
-            printf( YELLOW"\t[--Binary Search--] " RESET"Next Tc range: %f - %f \033[0m\n", _tclowbound, _tcupbound ) ;
-            return true;
-        }
-        cnffile.close();
+        TC_COMPONENT &comp = this->_component[loop] ;
+        this->_minisatexecnum += comp._probenum ;
+        this->_satconflictnum += comp._conflicts ;
+        this->_tcprovenlow = max( this->_tcprovenlow, comp._provenlow );
+        clausenum += comp._clausenum ;
+        if( comp._besttc == 0 ) proven = false ;
+        else for( long var = 0; var < (long)comp._var.size(); var++ ) model[ comp._var[var] - 1 ] = ( comp._model[var] > 0 ) ? comp._var[var] : -comp._var[var] ;
+        if( comp._timing.empty() && loop > 0 ) continue ;
+        lowbound = max( lowbound, comp._lowbound );
+        if( comp._upbound > tc ) { tc = comp._upbound ; critical = loop ; }
     }
-    else
+    if( clausenum > this->Max_timing_count ) this->Max_timing_count = clausenum ;
+    this->_tcupbound = tc ;
+    this->_tclowbound = lowbound ;
+    this->_tc = tc ;
+    if( proven )
     {
-        double minslack = 9999 ;
-        for( auto const& path: this->_pathlist )
+        this->_besttc     = tc ;
+        this->_bestmodel  = model ;
+        this->_phasemodel = model ;
+    }
+    printf( YELLOW"\t[--Component------] " RESET"%lu independent components, Tc = %f pinned by component %ld (%lu vars, %lu timing clauses)\n",
+            this->_component.size(), tc, critical, this->_component[critical]._var.size(), this->_component[critical]._timing.size() );
+}
+
+/////////////////////////////////////////////////////////////////////
+//
+// ClockTree Class - Private Method
+// Decode the DCC deployment/Leader selection from a SAT model
+// (DIMACS literal of var i at index i-1, 3 vars per unmasked clock node)
+//
+/////////////////////////////////////////////////////////////////////
+void ClockTree::decodeDccVTAFromModel( const vector<int> &model )
+{
+    //------ Clk Node Iteration (activation vars follow the node vars) --------------
+    long nodevar = min( (long)model.size(), this->getNodeVarNumber() );
+    for( long loop = 0; loop + 2 < nodevar; loop += 3 /*2*/ )
+    {
+        //-- Put DCC --------------------------------------------------------------
+        if( this->_placedcc && (( model[loop] > 0) || (model[loop + 1] > 0) ) )
         {
-            if((path->getPathType() != PItoFF) && (path->getPathType() != FFtoPO) && (path->getPathType() != FFtoFF))
-                continue;
-            // Update timing information
-            double slack = this->UpdatePathTiming( path, false, true, true );
+            ClockTreeNode *findnode = this->getVarNode( loop + 1 );
             
-            if( slack < minslack )
+            if( findnode != nullptr )
             {
-                minslack = min( slack, minslack );
+                findnode->setIfPlaceDcc(1)      ;
+                findnode->setDccType(model[loop], model[loop + 1], this->DC_1, this->DC_2, this->DC_N, this->DC_3 );
+                this->_dcclist.insert(pair<string, ClockTreeNode *> (findnode->getGateData()->getGateName(), findnode));
             }
+            else
+                cerr << "[Error] Clock node mismatch, when decoing DCC and Solution exist!\n" ;
         }
-        // Change the lower boundary
-        if( minslack <= 0)
-        {
-            this->_tclowbound = this->_tc;
-            this->_tc = ceilNPrecision((this->_tcupbound + this->_tclowbound) / 2, PRECISION);
-            printf( YELLOW"\t[Slack] " RESET "slack = " RED"%f \033[0m\n", minslack ) ;
-            printf( YELLOW"\t[Binary Search] " RESET"Next Tc range: %f - %f \033[0m\n", _tclowbound, _tcupbound ) ;
-        }
-        // Change the upper boundary
-        else if( minslack > 0)
+        //-- Put Header ------------------------------------------------------------
+        if( this->ifdoVTA() && ( model[loop + 2] > 0 ) )
         {
-            this->_besttc = this->_tc;
-            this->_tcupbound = this->_tc;
-            this->_tc = floorNPrecision((this->_tcupbound + this->_tclowbound) / 2, PRECISION);
-            printf( YELLOW"\t[Slack] " RESET "slack = " GREEN"%f \033[0m\n", minslack ) ;
-            printf( YELLOW"\t[Binary Search] " RESET"Next Tc range: %f - %f \033[0m\n", _tclowbound, _tcupbound ) ;
+            ClockTreeNode *findnode = this->getVarNode( loop + 1 );
+            
+            if( findnode != nullptr )
+            {
+                findnode->setIfPlaceHeader(1);
+                findnode->setVTAType(0);
+                this->_VTAlist.insert(pair<string, ClockTreeNode *> (findnode->getGateData()->getGateName(), findnode));
+            }
+            else
+                cerr << "[Error] Clock node mismatch, when decoing VTA and Solution exist!\n" ;
         }
     }
-    return false;
 }
 
-
 /////////////////////////////////////////////////////////////////////
 //
 // ClockTree Class - Public Method
@@ -3015,28 +4587,14 @@ bool ClockTree::tcBinarySearch( )
 /////////////////////////////////////////////////////////////////////
 void ClockTree::updateAllPathTiming(void)
 {
-    //-- Declare -------------------------------------------------------------------------
-	double minslack = 9999          ;
-	
     //-- If Place DCC or VTA --------------------------------------------------------------
     //-- DCC or VTA Decoding --------------------------------------------------------------
     if( this->_placedcc || this->ifdoVTA() )
     {
-        //-- Read CNF (Minisat Output) -------------------------------------------------------
-        fstream cnffile ;
-        string  line = "" ;
-        string  lastsatfile = "";
-        lastsatfile = this->_outputdir + "cnfoutput_" + to_string(this->_besttc);
-        if( !isFileExist(lastsatfile) )
-        {
-            cerr << "\033[31m[Error]: File \"" << lastsatfile << "\" does not found!\033[0m\n";
-            return;
-        }
-        cnffile.open(lastsatfile, ios::in);
-        if( !cnffile.is_open() )
+        //-- Model of the optimal Tc ---------------------------------------------------------
+        if( this->_bestmodel.empty() )
         {
-            cerr << "\033[31m[Error]: Cannot open " << lastsatfile << "\033[0m\n";
-            cnffile.close();
+            cerr << "\033[31m[Error]: No SAT solution found at Tc = " << this->_besttc << "!\033[0m\n";
             return;
         }
         this->_tc = this->_besttc ;
@@ -3046,93 +4604,167 @@ void ClockTree::updateAllPathTiming(void)
             node.second->setIfPlaceDcc(0)   ;
             node.second->setIfPlaceHeader(0);
         }
-        
-        getline(cnffile, line) ;
-        //-- Solution Exist ---------------------------------------------------------------
-        if( (line.size() == 3) && (line.find("SAT") != string::npos) )
-        {
-            getline(cnffile, line) ;
-            vector<string> strspl = stringSplit(line, " ");
-            //------ Clk Node Iteration ---------------------------------------------------
-            for( long loop = 0; ; loop += 3 /*2*/ )
-            {
-                //-- End of CNF -----------------------------------------------------------
-                if( stoi( strspl[loop] ) == 0 ) break ;
-                
-                //-- Put DCC --------------------------------------------------------------
-                if( this->_placedcc && (( stoi(strspl.at(loop)) > 0) || (stoi(strspl.at(loop + 1)) > 0) ) )
-                {
-                    ClockTreeNode *findnode = this->searchClockTreeNode(abs(stoi(strspl.at(loop))));
-                
-                    if( findnode != nullptr )
-                    {
-                        findnode->setIfPlaceDcc(1)      ;
-                        findnode->setDccType(stoi(strspl.at(loop)), stoi(strspl.at(loop + 1)), this->DC_1, this->DC_2, this->DC_N, this->DC_3 );
-                        this->_dcclist.insert(pair<string, ClockTreeNode *> (findnode->getGateData()->getGateName(), findnode));
-                        //printf("[Info] Insert DCC\n");
-                    }
-                    else
-                        cerr << "[Error] Clock node mismatch, when decoing DCC and Solution exist!\n" ;
-                }
-                //-- Put Header ------------------------------------------------------------
-                if( this->ifdoVTA() && ( stoi(strspl.at(loop+2)) > 0 ) )
-                {
-                    ClockTreeNode *findnode = this->searchClockTreeNode(abs(stoi(strspl.at(loop))));
-                    
-                    if( findnode != nullptr )
-                    {
-                        findnode->setIfPlaceHeader(1);
-                        findnode->setVTAType(0);
-                        this->_VTAlist.insert(pair<string, ClockTreeNode *> (findnode->getGateData()->getGateName(), findnode));
-                        //printf("[Info] Insert VTA Header\n");
-                    }
-                    else
-                        cerr << "[Error] Clock node mismatch, when decoing VTA and Solution exist!\n" ;
-                }
-            }
-            cnffile.close() ;
-            for( auto const& path: this->_pathlist )
-            {
-                if((path->getPathType() != PItoFF) && (path->getPathType() != FFtoPO) && (path->getPathType() != FFtoFF))
-                    continue;
-                // Update timing information
-                double slack = this->UpdatePathTiming( path, true, true, true );
-                
-                if( slack < minslack )
-                {
-                    this->_mostcriticalpath = path;
-                    minslack = min( slack, minslack );
-                }
-            }
-        }
-        //-- Solution Not Exist ------------------------------------------------------------
-        else
-        {
-            cerr << "\033[31m[Error]: File \"" << lastsatfile << "\" is not SAT!\033[0m\n";
-            return ;
-        }
+        //-- Decode DCC/Leader ------------------------------------------------------------
+        this->decodeDccVTAFromModel( this->_bestmodel );
+        // Update timing information
+        this->sweepPathTiming( true, true, true, false, &this->_mostcriticalpath );
     }
     //-- If No DCC insertion && no VTA -----------------------------------------------------
     else
+        this->sweepPathTiming( true, true, true, false, &this->_mostcriticalpath );
+	// Count the DCCs inserting at final buffer
+	for(auto const& node: this->_dcclist)
+		if(node.second->ifPlacedDcc() && node.second->isFinalBuffer())
+			this->_dccatlastbufnum++;
+}
+
+/////////////////////////////////////////////////////////////////////
+//
+// ClockTree Class - Private Method
+// Index the paths by the clock nodes of their clock paths (the
+// latency of a clock path only depends on its own nodes)
+//
+/////////////////////////////////////////////////////////////////////
+void ClockTree::buildNodePathIndex(void)
+{
+    this->_nodepath.assign( this->_totalnodenum / 3 + 1, vector< long >() );
+    for( long loop = 0 ; loop < (long)this->_pathlist.size() ; loop++ )
     {
-        for( auto const& path: this->_pathlist )
-        {
-            if((path->getPathType() != PItoFF) && (path->getPathType() != FFtoPO) && (path->getPathType() != FFtoFF))
-                continue;
-            // Update timing information
-            double slack = this->UpdatePathTiming( path );
-            
-            if( slack < minslack )
+        CP *path = this->_pathlist[loop] ;
+        if( path->getPathType() == NONE ) continue ;
+        for( auto const& clkpath: { &path->getStartPonitClkPath(), &path->getEndPonitClkPath() } )
+            for( auto const& node: *clkpath )
             {
-                this->_mostcriticalpath = path;
-                minslack = min( slack, minslack );
+                long id = ( node->getNodeNumber() - 1 ) / 3 ;
+                if( id >= (long)this->_nodepath.size() ) this->_nodepath.resize( id + 1 );
+                //-- Common nodes of both clock paths are indexed once --------------------
+                if( this->_nodepath[id].empty() || this->_nodepath[id].back() != loop )
+                    this->_nodepath[id].push_back( loop );
             }
+    }
+}
+
+/////////////////////////////////////////////////////////////////////
+//
+// ClockTree Class - Public Method
+// Time every path (except NONE) by UpdatePathTiming with the given
+// arguments, then keep the slacks up to date by retimeClockNode
+// after each edit (DCC, leader, clock gating, inserted buffer) of a
+// clock node, which re-times the paths passing through the node only.
+//
+/////////////////////////////////////////////////////////////////////
+void ClockTree::initIncrementalTiming( bool update, bool DCCVTA, bool aging, bool set )
+{
+    if( this->_nodepath.empty() ) this->buildNodePathIndex();
+    this->_staupdate = update ;
+    this->_stadccvta = DCCVTA ;
+    this->_staaging  = aging  ;
+    this->_staset    = set    ;
+    this->_statc     = this->_tc ;
+    this->_staslack.assign( this->_pathlist.size(), 0 );
+    this->_staorder.clear();
+    this->_staviolation.clear();
+    for( long loop = 0 ; loop < (long)this->_pathlist.size() ; loop++ )
+    {
+        if( this->_pathlist[loop]->getPathType() == NONE ) continue ;
+        this->_staslack[loop] = this->UpdatePathTiming( this->_pathlist[loop], update, DCCVTA, aging, set );
+        this->_staorder.insert( make_pair( this->_staslack[loop], loop ) );
+        if( this->_staslack[loop] < 0 ) this->_staviolation.insert( loop );
+    }
+}
+
+/////////////////////////////////////////////////////////////////////
+//
+// ClockTree Class - Private Method
+// Re-time a path (index in _pathlist) of the incremental timing
+//
+/////////////////////////////////////////////////////////////////////
+void ClockTree::retimePath( long loop )
+{
+    double slack = this->UpdatePathTiming( this->_pathlist[loop], this->_staupdate, this->_stadccvta, this->_staaging, this->_staset );
+    this->_staorder.erase( make_pair( this->_staslack[loop], loop ) );
+    this->_staslack[loop] = slack ;
+    this->_staorder.insert( make_pair( slack, loop ) );
+    if( slack < 0 ) this->_staviolation.insert( loop );
+    else            this->_staviolation.erase( loop );
+    this->_staretimenum++ ;
+}
+
+/////////////////////////////////////////////////////////////////////
+//
+// ClockTree Class - Public Method
+// Update the incremental timing after an edit of the clock node (or
+// of its children, whose paths pass through the node as well)
+//
+/////////////////////////////////////////////////////////////////////
+void ClockTree::retimeClockNode( CTN *node )
+{
+    if( node == nullptr ) return ;
+    //-- Slacks of another Tc ----------------------------------------------------------
+    if( this->_tc != this->_statc )
+        this->initIncrementalTiming( this->_staupdate, this->_stadccvta, this->_staaging, this->_staset );
+    else
+    {
+        long id = ( node->getNodeNumber() - 1 ) / 3 ;
+        if( id < (long)this->_nodepath.size() )
+            for( long loop: this->_nodepath[id] ) this->retimePath( loop );
+    }
+    if( this->_stacheck ) this->checkIncrementalTiming();
+}
+
+/////////////////////////////////////////////////////////////////////
+//
+// ClockTree Class - Private Method
+// "-sta_check": compare the slacks of the incremental timing with
+// the ones of a full recomputation
+//
+/////////////////////////////////////////////////////////////////////
+void ClockTree::checkIncrementalTiming(void)
+{
+    long mismatch = 0 ;
+    for( long loop = 0 ; loop < (long)this->_pathlist.size() ; loop++ )
+    {
+        if( this->_pathlist[loop]->getPathType() == NONE ) continue ;
+        double slack = this->UpdatePathTiming( this->_pathlist[loop], false, this->_stadccvta, this->_staaging );
+        if( abs( slack - this->_staslack[loop] ) > TCDB_EPSILON )
+        {
+            if( mismatch == 0 )
+                printf( RED"\t[STA check] " RESET"path %ld: incremental slack %f, full recomputation %f\n", this->_pathlist[loop]->getPathNum(), this->_staslack[loop], slack );
+            mismatch++ ;
         }
     }
-	// Count the DCCs inserting at final buffer
-	for(auto const& node: this->_dcclist)
-		if(node.second->ifPlacedDcc() && node.second->isFinalBuffer())
-			this->_dccatlastbufnum++;
+    if( mismatch > 0 ) printf( RED"\t[STA check] " RESET"%ld mismatched path(s)\n", mismatch );
+}
+
+/////////////////////////////////////////////////////////////////////
+//
+// ClockTree Class - Public Method
+// Worst slack of the incremental timing (9999: no timed path)
+// Output: path of the worst slack
+//
+/////////////////////////////////////////////////////////////////////
+double ClockTree::getWorstSlack( CP **path )
+{
+    if( path != nullptr ) *path = ( this->_staorder.empty() ) ? nullptr : this->_pathlist[ this->_staorder.begin()->second ] ;
+    return ( this->_staorder.empty() ) ? 9999 : this->_staorder.begin()->first ;
+}
+
+/////////////////////////////////////////////////////////////////////
+//
+// ClockTree Class - Public Method
+// First path (in the order of _pathlist) with negative slack of the
+// incremental timing, PItoPO excluded (nullptr: none)
+//
+/////////////////////////////////////////////////////////////////////
+CP* ClockTree::getFirstViolatingPath( bool withFFtoPO )
+{
+    for( long loop: this->_staviolation )
+    {
+        int type = this->_pathlist[loop]->getPathType() ;
+        if( type == PItoPO || ( !withFFtoPO && type == FFtoPO ) ) continue ;
+        return this->_pathlist[loop] ;
+    }
+    return nullptr ;
 }
 
 /////////////////////////////////////////////////////////////////////
@@ -3176,56 +4808,56 @@ void ClockTree::minimizeDccPlacement(void)
 	for(auto const& node: dcclist)//the dcclist is "redundant dcc list"?
 		node.second->setIfPlaceDcc(0);
 	this->_tc = this->_besttc;
+	this->initIncrementalTiming( false, true, true );
 	// Greedy minimization
 	while( true )
 	{
 		if( dcclist.empty()) break;
-		bool endflag = 1, findstartpath = 1;
+		bool findstartpath = 1;
 		// Reserve one of the rest of DCCs above if one of critical paths occurs timing violation
-		for(auto const& path: this->_pathlist)
+		CriticalPath *path = this->getFirstViolatingPath();
+		if( path == nullptr ) break;
+		for(finddccptr = dcclist.begin();finddccptr != dcclist.end();)
 		{
-			if((path->getPathType() != PItoFF) && (path->getPathType() != FFtoPO) && (path->getPathType() != FFtoFF))
-				continue;
-			// Assess if the critical path occurs timing violation in the DCC deployment
-			double slack = this->UpdatePathTiming( path, false ) ;
-			if( slack < 0 )
+			if(finddccptr->second->ifPlacedDcc())
+				finddccptr = dcclist.erase(finddccptr);
+			else
+				finddccptr++;
+		}
+		// Reserve the DCC locate in the clock path of endpoint
+		for(auto const& node: path->getEndPonitClkPath())
+		{
+			finddccptr = dcclist.find(node->getGateData()->getGateName());
+			if((finddccptr != dcclist.end()) && !finddccptr->second->ifPlacedDcc())
 			{
-				endflag = 0;
-				for(auto const& node: dcclist)
-					if(node.second->ifPlacedDcc())
-						dcclist.erase(node.first);
-				// Reserve the DCC locate in the clock path of endpoint
-				for(auto const& node: path->getEndPonitClkPath())
-				{
-					finddccptr = dcclist.find(node->getGateData()->getGateName());
-					if((finddccptr != dcclist.end()) && !finddccptr->second->ifPlacedDcc())
-					{
-						finddccptr->second->setIfPlaceDcc(1);
-						findstartpath = 0;
-					}
-				}
-				// Reserve the DCC locate in the clock path of startpoint
-				if(findstartpath)
+				finddccptr->second->setIfPlaceDcc(1);
+				this->retimeClockNode(finddccptr->second);
+				findstartpath = 0;
+			}
+		}
+		// Reserve the DCC locate in the clock path of startpoint
+		if(findstartpath)
+		{
+			for(auto const& node: path->getStartPonitClkPath())
+			{
+				finddccptr = dcclist.find(node->getGateData()->getGateName());
+				if((finddccptr != dcclist.end()) && !finddccptr->second->ifPlacedDcc())
 				{
-					for(auto const& node: path->getStartPonitClkPath())
-					{
-						finddccptr = dcclist.find(node->getGateData()->getGateName());
-						if((finddccptr != dcclist.end()) && !finddccptr->second->ifPlacedDcc())
-							finddccptr->second->setIfPlaceDcc(1);
-					}
+					finddccptr->second->setIfPlaceDcc(1);
+					this->retimeClockNode(finddccptr->second);
 				}
-				break;
 			}
 		}
-		if( endflag ) break;
 	}
-	for(auto const& node: this->_dcclist)
+	for(finddccptr = this->_dcclist.begin();finddccptr != this->_dcclist.end();)
 	{
-		if(!node.second->ifPlacedDcc())
+		if(!finddccptr->second->ifPlacedDcc())
 		{
-			node.second->setDccType(0);
-			this->_dcclist.erase(node.first);
+			finddccptr->second->setDccType(0);
+			finddccptr = this->_dcclist.erase(finddccptr);
 		}
+		else
+			finddccptr++;
 	}
 	this->_dccatlastbufnum = 0;
 	// Count the DCCs inserting at final buffer
@@ -3236,7 +4868,9 @@ void ClockTree::minimizeDccPlacement(void)
 /////////////////////////////////////////////////////////////////////
 //
 // ClockTree Class - Public Method
-// Recheck the optimal Tc if it is minimum
+// Recheck the optimal Tc if it is minimum. With the deployment fixed,
+// slack is linear in Tc, so the minimum Tc (on the grid of PRECISION
+// below the optimal Tc) comes from the minimum slack (aging/fresh)
 //
 /////////////////////////////////////////////////////////////////////
 void ClockTree::tcRecheck(void)
@@ -3248,39 +4882,23 @@ void ClockTree::tcRecheck(void)
 	cout << "\t*** Optimal tc                     : \033[36m" << this->_besttc << "\033[0m\n";
 	if(this->_mostcriticalpath->getSlack() < 0)
 		this->_besttc += ceilNPrecision(abs(this->_mostcriticalpath->getSlack()), PRECISION);
-	double oribesttc = this->_besttc;
-	double slack_aging = 0;
-	double slack_fresh = 0;
-	while( 1 )
-	{
-		bool endflag = 0;
-		// Decrease the optimal Tc
-		this->_tc = this->_besttc - (1 / pow(10, PRECISION));
-		if( this->_tc < 0 ) break;
-		// Assess if the critical path occurs timing violation
-		for(auto const& path: this->_pathlist)
-		{
-			if((path->getPathType() != PItoFF) && (path->getPathType() != FFtoPO) && (path->getPathType() != FFtoFF)) continue;
-			
-            slack_aging = this->UpdatePathTiming( path, 0, 1, 1 ) ;
-			slack_fresh = this->UpdatePathTiming( path, 0, 1, 0 ) ;
-			if( slack_aging < 0 || slack_fresh < 0 )
-			{
-				endflag = 1;
-				break;
-			}
-		}
-		if( endflag ) break ;
-		this->_besttc = this->_tc;
-	}
-	if( oribesttc == this->_besttc ) return;
+	double step = 1 / pow(10, PRECISION);
+	// Minimum slack at the optimal Tc
 	this->_tc = this->_besttc;
-	// Update timing information of all critical path based on the new optimal Tc
-	for( auto const& path: this->_pathlist )
+	double minslack = min( this->sweepPathTiming( 0, 1, 1 ), this->sweepPathTiming( 0, 1, 0 ) );
+	// Decrease the optimal Tc by the steps the minimum slack covers (Tc >= 0)
+	long   stepnum  = (long)min( floor( minslack / step ), floor( this->_besttc / step ) );
+	if( stepnum <= 0 ) return;
+	this->_tc = this->_besttc - stepnum * step;
+	// Rounding error of the steps: give the last one back
+	if( this->sweepPathTiming( 0, 1, 1 ) < 0 || this->sweepPathTiming( 0, 1, 0 ) < 0 )
 	{
-		if((path->getPathType() != PItoFF) && (path->getPathType() != FFtoPO) && (path->getPathType() != FFtoFF)) continue;
-        this->UpdatePathTiming( path, 1, 1, 1 ) ;
+		if( --stepnum <= 0 ) return;
+		this->_tc = this->_besttc - stepnum * step;
 	}
+	this->_besttc = this->_tc;
+	// Update timing information of all critical path based on the new optimal Tc
+	this->sweepPathTiming( 1, 1, 1 ) ;
 }
 
 /////////////////////////////////////////////////////////////////////
@@ -3294,6 +4912,7 @@ void ClockTree::bufferInsertion(void)
 {
 	if((this->_bufinsert < 1) || (this->_bufinsert > 2))
 		return;
+	this->_clklatenready = false ;//clock latency table is stale
 	cout << "\033[32m[Info]: Inserting Buffer (Tc = " << this->_besttc << " )...\033[0m\n";
 	this->_tc = this->_besttc;
 	for(int counter = 1;;counter++)
@@ -3362,6 +4981,7 @@ void ClockTree::minimizeBufferInsertion(void)
 {
 	if((this->_bufinsert != 3) || (this->_insertbufnum < 3))
 		return;
+	this->_clklatenready = false ;//clock latency table is stale
 	cout << "\033[32m[Info]: Minimizing Buffer Insertion...\033[0m\n";
 	cout << "\033[32m    Before Buffer Insertion Minimization\033[0m\n";
 	this->printBufferInsertedList();
@@ -3788,12 +5408,58 @@ void ClockTree::printBufferInsertedList(void)
 		}
 	}
 }
+/*-------------------------------------------------------------
+ Func Name:
+    getDCType()
+ Introduction:
+    Duty cycle given by DCCs => DC_TYPE (DCT_NONE: other duty
+    cycles, e.g., the ones of gated clock buffers)
+ --------------------------------------------------------------*/
+DC_TYPE ClockTree::getDCType( double DC )
+{
+    if( DC == -1 || DC == 0 )       return DCT_N ;
+    if( DC == this->DC_N )          return DCT_N ;
+    if( DC == this->DC_1 )          return DCT_1 ;
+    if( DC == this->DC_2 )          return DCT_2 ;
+    if( DC == this->DC_3 )          return DCT_3 ;
+    if( DC == this->DC_1_age )      return DCT_1_AGE ;
+    if( DC == this->DC_2_age )      return DCT_2_AGE ;
+    if( DC == this->DC_3_age )      return DCT_3_AGE ;
+    return DCT_NONE ;
+}
+/*-------------------------------------------------------------
+ Func Name:
+    buildAgingRateTable()
+ Introduction:
+    Aging rate of each (Vth lib, DC type, fresh/aged), for the
+    nominal Vth (lib -1) and every Vth lib read so far. The
+    aging rates of other duty cycles are cached on demand by
+    each thread (dropped when the table is rebuilt).
+ --------------------------------------------------------------*/
+void ClockTree::buildAgingRateTable()
+{
+    const double dcvalue[DCT_NUM] = { this->DC_1, this->DC_2, this->DC_N, this->DC_3, this->DC_1_age, this->DC_2_age, this->DC_3_age };
+    long libnum = (long)this->getLibList().size() ;
+    this->_agingratelut.assign( ( libnum + 1 )*DCT_NUM*2, 1 );
+    for( int lib = -1 ; lib < libnum ; lib++ )
+    {
+        double fresh = ( lib == -1 ) ? 1 : ( 1 + 2*this->getLibList().at(lib)->_VTH_OFFSET ) ;
+        for( int type = 0 ; type < DCT_NUM ; type++ )
+        {
+            this->_agingratelut[ ( ( lib + 1 )*DCT_NUM + type )*2     ] = fresh ;
+            this->_agingratelut[ ( ( lib + 1 )*DCT_NUM + type )*2 + 1 ] = this->getAgingRate_givDC_givVth( dcvalue[type], lib, true );
+        }
+    }
+    this->_agingrategen++ ;
+}
 /*-------------------------------------------------------------
  Func Name:
     getAgingRatee_givDC_givVth()
  Introduction:
     Calculate the aging rate of buffer
     by given duty cycle and given Vth offset.
+    initial = 1: calculate it (for buildAgingRateTable)
+    initial = 0: read it from the aging rate table
  Note:
     The aging rate will differ from ones that gotten from seniors
  --------------------------------------------------------------*/
@@ -3807,7 +5473,10 @@ double ClockTree::getAgingRate_givDC_givVth( double DC, int Libindex, bool initi
         if( this->_usingSeniorAging == true  )
             return (1 + (((-0.117083333333337) * (DC) * (DC)) + (0.248750000000004 * (DC)) + 0.0400333333333325));
         
-        if( Libindex != -1 )
+        //---- No Vth lib: Sv of the nominal Vth are not tabulated --------
+        if( Libindex == -1 && this->getLibList().empty() )
+            Sv = this->calSv( DC, this->getBaseVthOffset(), this->calConvergentVth( DC, this->getExp() ) ) ;
+        else if( Libindex != -1 )
         {
             if( DC == this->DC_1 )
                 Sv = this->getLibList().at(Libindex)->_Sv[7] ;
@@ -3863,76 +5532,42 @@ double ClockTree::getAgingRate_givDC_givVth( double DC, int Libindex, bool initi
         double agr = 0 ;
         if( Libindex == -1 )    agr = (1 + Vth_nbti*2 + 0 ) ;
         else                    agr = (1 + Vth_nbti*2 + 2*this->getLibList().at(Libindex)->_VTH_OFFSET ) ;
-		
-		
-        if( Libindex == -1 ){
-            if(      DC == this->DC_N )     this->_nominal_agr[2] = agr ;
-            else if( DC == this->DC_1 )     this->_nominal_agr[0] = agr ;
-            else if( DC == this->DC_2 )     this->_nominal_agr[1] = agr ;
-            else if( DC == this->DC_3 )     this->_nominal_agr[3] = agr ;
-            else if( DC == this->DC_1_age ) this->_nominal_agr[4] = agr ;
-            else if( DC == this->DC_2_age ) this->_nominal_agr[5] = agr ;
-            else if( DC == this->DC_3_age ) this->_nominal_agr[6] = agr ;
-
-        }else{
-			this->_HTV_fresh = (1 + 2*this->getLibList().at(Libindex)->_VTH_OFFSET ) ;
-            if(      DC == this->DC_N ) 	this->_HTV_agr[2] = agr  ;
-            else if( DC == this->DC_1 )     this->_HTV_agr[0] = agr  ;
-            else if( DC == this->DC_2 )     this->_HTV_agr[1] = agr  ;
-            else if( DC == this->DC_3 )     this->_HTV_agr[3] = agr  ;
-            else if( DC == this->DC_1_age ) this->_HTV_agr[4] = agr  ;
-            else if( DC == this->DC_2_age ) this->_HTV_agr[5] = agr  ;
-            else if( DC == this->DC_3_age ) this->_HTV_agr[6] = agr  ;
-        }
         return agr ;
-    }else//initial
+    }
+    if( Libindex < -1 || Libindex >= (long)this->getLibList().size() )
     {
-		
-        if( Libindex == -1 )
-        {
-			if( caging == false )				return 1 ;
-            else if( DC == this->DC_N )  		return this->_nominal_agr[2] ;
-            else if( DC == this->DC_1 )         return this->_nominal_agr[0] ;
-            else if( DC == this->DC_2 )         return this->_nominal_agr[1] ;
-            else if( DC == this->DC_3 )         return this->_nominal_agr[3] ;
-            else if( DC == this->DC_1_age )     return this->_nominal_agr[4] ;
-            else if( DC == this->DC_2_age )     return this->_nominal_agr[5] ;
-            else if( DC == this->DC_3_age )     return this->_nominal_agr[6] ;
-			else
-			{
-				double conv_Vth = this->calConvergentVth( DC, this->getExp() ) ;//80% DCC
-				double Sv = 0;
-				double Vth_offset = this->getBaseVthOffset() ;
-				Sv = this->calSv( DC , this->getBaseVthOffset(), conv_Vth ) ;
-				double Vth_nbti = ( 1 - Sv*Vth_offset )*( 0.0039/2 )*( pow( DC*( 315360000 ), this->getExp() ) );
-				double agr = (1 + Vth_nbti*2 + 0 ) ;
-				return agr;
-			}
-			
-        }else
-        {
-			if( caging == false )				return this->_HTV_fresh  ;
-            else if( DC == this->DC_N ) 		return this->_HTV_agr[2] ;
-            else if( DC == this->DC_1 )         return this->_HTV_agr[0] ;
-            else if( DC == this->DC_2 )         return this->_HTV_agr[1] ;
-            else if( DC == this->DC_3 )         return this->_HTV_agr[3] ;
-            else if( DC == this->DC_1_age )     return this->_HTV_agr[4] ;
-            else if( DC == this->DC_2_age )     return this->_HTV_agr[5] ;
-            else if( DC == this->DC_2_age )     return this->_HTV_agr[6] ;
-			else
-			{
-				double conv_Vth = this->calConvergentVth( DC, this->getExp() ) ;//80% DCC
-				double Sv = 0;
-				double Vth_offset = this->getLibList().at(Libindex)->_VTH_OFFSET + this->getBaseVthOffset() ;
-				Sv = this->calSv( DC , this->getLibList().at(Libindex)->_VTH_OFFSET + this->getBaseVthOffset(), conv_Vth ) ;
-				double Vth_nbti = ( 1 - Sv*Vth_offset )*( 0.0039/2 )*( pow( DC*( 315360000 ), this->getExp() ) );
-				double agr = (1 + Vth_nbti*2 + 2*this->getLibList().at(Libindex)->_VTH_OFFSET )  ;
-				
-				return agr;
-			}
-        }
+        cerr << "[Error] Irrecognized Vth lib in func \"getAgingRate_givDC_givVth (double DC, int LibIndex )\"    \n" ;
+        return -1 ;
+    }
+    //---- Duty cycles of DCCs (fresh buffers don't depend on DC) -------
+    DC_TYPE type = this->getDCType( DC );
+    if( type != DCT_NONE || !caging )
+        return this->getAgingRate_givDCType_givVth( ( type != DCT_NONE ) ? type : DCT_N, Libindex, caging );
+    //---- Other duty cycles (clock gating), cached per thread ----------
+    static thread_local const ClockTree *cacheowner = nullptr ;
+    static thread_local long             cachegen   = 0 ;
+    static thread_local map< pair< double, int >, double > cache ;
+    if( cacheowner != this || cachegen != this->_agingrategen )
+    {
+        cache.clear();
+        cacheowner = this ;
+        cachegen   = this->_agingrategen ;
     }
-    return -1 ;
+    auto found = cache.find( make_pair( DC, Libindex ) );
+    if( found != cache.end() ) return found->second ;
+    double Vth_offset = this->getBaseVthOffset() ;
+    double lib_offset = 0 ;
+    if( Libindex != -1 )
+    {
+        lib_offset  = this->getLibList().at(Libindex)->_VTH_OFFSET ;
+        Vth_offset += lib_offset ;
+    }
+    double conv_Vth = this->calConvergentVth( DC, this->getExp() ) ;
+    double Sv       = this->calSv( DC, Vth_offset, conv_Vth ) ;
+    double Vth_nbti = ( 1 - Sv*Vth_offset )*( 0.0039/2 )*( pow( DC*( 315360000 ), this->getExp() ) );
+    double agr      = (1 + Vth_nbti*2 + 2*lib_offset ) ;
+    cache[ make_pair( DC, Libindex ) ] = agr ;
+    return agr ;
 }
 /*-------------------------------------------------------------
  Func Name:
@@ -4174,6 +5809,8 @@ void ClockTree::dumpDccVTALeaderToFile()
 {
     FILE *fPtr;
     string filename = this->_outputdir + "DccVTA_" + to_string( this->_tc ) + ".txt";
+    if( !isDirectoryExist(this->_outputdir) )
+        mkdir(this->_outputdir.c_str(), 0775);
     fPtr = fopen( filename.c_str(), "w" );
     fprintf( fPtr, "Tc %f\n", this->_tc );
 	
@@ -4271,6 +5908,7 @@ void ClockTree::printClkNodeFeature( ClockTreeNode *clknode, bool doDCCVTA )
 
 void ClockTree::InitClkTree()
 {
+    this->_clklatenready = false ;//clock latency table is stale
     this->_dcclist.clear();
     this->_VTAlist.clear();
     for( auto clknode: this->_buflist )
@@ -4324,7 +5962,7 @@ void ClockTree::dumpCNF()
     getline( cnffile, line ) ;//Read DCC/VTA
     vector<string> strspl = stringSplit( line, " " );
     //------ Clk Node Iteration ---------------------------------------------------
-    for( long loop = 0; ; loop += 3 /*2*/ )
+    for( long loop = 0; loop + 2 < this->getNodeVarNumber(); loop += 3 /*2*/ )
     {
         //-- End of CNF -----------------------------------------------------------
         if( stoi( strspl[loop] ) == 0 ) break ;
@@ -4333,7 +5971,7 @@ void ClockTree::dumpCNF()
         if( !( stoi(strspl.at(loop+2)) > 0 || stoi(strspl.at(loop)) > 0 || stoi(strspl.at(loop + 1)) > 0 ) ) continue ;
         else
         {
-            ClockTreeNode *findnode = this->searchClockTreeNode(abs(stoi(strspl.at(loop))));
+            ClockTreeNode *findnode = this->getVarNode( loop + 1 );
             if( !findnode ) cerr << RED"[Error] " RESET"Unrecognized Clknode ID " << strspl[loop] <<" in dumpUnsatCNF()\n";
             else
             {
@@ -4374,22 +6012,26 @@ void ClockTree::CheckTiming_givFile()
 	double slack_fresh = 0;
 	string PassFail = "" ;
 	string PathType = "" ;
+	vector<double> agingslack, freshslack ;
 	
-    for( auto const& path: this->_pathlist )
+    this->sweepPathTiming( 1/*Update*/, 1/*Consider DCC*/, 1/*Consider Aging*/, 0, nullptr, &agingslack );
+    this->sweepPathTiming( 0/*Update*/, 1/*Consider DCC*/, 0/*Consider Aging*/, 0, nullptr, &freshslack );
+    for( long loop = 0; loop < (long)this->_pathlist.size(); loop++ )
     {
+        CP *path = this->_pathlist[loop] ;
 		if( path->getPathType() == PItoFF )         PathType = "PItoFF" ;
 		else if( path->getPathType() == PItoFF )    PathType = "FFtoPO" ;
 		else if( path->getPathType() == FFtoFF )    PathType = "FFtoFF" ;
 		else                                        continue            ;
 	
-        slack_aging = this->UpdatePathTiming( path, 1/*Update*/, 1/*Consider DCC*/, 1/*Consider Aging*/ );
+        slack_aging = agingslack[loop] ;
         if( slack_aging < 0 )
         {
 			printf( CYAN"[Timing Constraint (10-yr aging)]" RED"[Violated]" RST"Path( %ld, %s ) fail, slack = " RED"%f\n", path->getPathNum(), PathType.c_str(), slack_aging );
             fail = 1 ;
         }
 		
-		slack_fresh = this->UpdatePathTiming( path, 0/*Update*/, 1/*Consider DCC*/, 0/*Consider Aging*/ );
+		slack_fresh = freshslack[loop] ;
 		if( slack_fresh < 0 )
 		{
 			printf( CYAN"[Timing Constraint (Fresh)] " RED"[Violated] " RESET"Path( %ld, %s ) fail, slack = " RED"%f\n" RESET, path->getPathNum() ,PathType.c_str(),slack_fresh );
@@ -7,8 +7,13 @@
 #include "clocktree3.h"
 #include <assert.h>
 #include "utility.h"
+#include "satsolver.h"
+#include "clausearena.h"
 #include <map>
 #include <set>
+#include <mutex>
+#include <atomic>
+#include <functional>
 
 // Factor of DCC delay based on logic effort
 #define DCCDELAY20PA    (1.33)		// 20% DCC Delay
@@ -23,6 +28,8 @@
 #define PATHMASKPERCENT (1.0)	    // Mask how many percentage of critical path (0~1)
 #define TenYear_Sec     (315360000)
 #define COF_A           (0.0039/2)
+#define TCDB_EPSILON    (1e-9)      // Margin of the prefix scan of the timing clause DB
+#define PORTFOLIO_MAX   (4)         // # of solver configurations of "-portfolio"
 #define CTN             ClockTreeNode
 #define CP              CriticalPath
 #define CT              ClockTree
@@ -47,6 +54,130 @@ struct VTH_TECH
         _VTH_CONVGNT[0] = _VTH_CONVGNT[1] =_VTH_CONVGNT[2] =_VTH_CONVGNT[3] = 0.0 ;
     }
 };
+/*------------------------------------------------------------------
+ Data Type Name:
+    TIMING_CLAUSE
+ Introduction:
+    A timing clause of one (path, DCC, header) configuration.
+    slack = ( _reqtime + Tc ) - _avltime, so the clause is needed
+    iff Tc < _tcth (critical Tc of the configuration)
+ -------------------------------------------------------------------*/
+struct TIMING_CLAUSE
+{
+    double _tcth    ;//critical Tc = _avltime - _reqtime
+    double _avltime ;//ci + Tin + Tcq + Dij
+    double _reqtime ;//cj + Tsu (without Tc)
+    long   _clause  ;//index in _tcclausearena
+    string _log     ;//prefix of the line in clause_<tc>.txt (-print=Clause)
+    long   _pathnum ;//critical path of the configuration
+    long   _stlitnum;//# literals of the launch clock path, first in the clause (until encodeLatencyVar)
+};
+/*------------------------------------------------------------------
+ Data Type Name:
+    TIMING_CLAUSE_BUF
+ Introduction:
+    Timing clauses of one chunk of paths, generated by a worker of
+    "-threads N" (entries in order of generation, _clause is an
+    index in _arena). Chunks are merged into the DB in path order.
+ -------------------------------------------------------------------*/
+struct TIMING_CLAUSE_BUF
+{
+    ClauseArena             _arena  ;
+    vector< TIMING_CLAUSE > _db     ;
+};
+/*------------------------------------------------------------------
+ Data Type Name:
+    TIMING_SWEEP
+ Introduction:
+    One sweep of UpdatePathTiming over the timed paths (PItoFF,
+    FFtoPO, FFtoFF), split into chunks taken by the workers of
+    "-threads N". Each chunk keeps its first path of minimum slack,
+    so merging the chunks in path order gives the sequential result.
+ -------------------------------------------------------------------*/
+struct TIMING_SWEEP
+{
+    bool                          _update, _dccvta, _aging, _cpv ;//arguments of UpdatePathTiming
+    vector< double >             *_slacks   ;//slack of each path (by index in _pathlist), or nullptr
+    vector< pair<double, long> >  _chunkmin ;//(min slack, path index) of each chunk
+    atomic< long >                _nextchunk;
+};
+/*------------------------------------------------------------------
+ Data Type Name:
+    TC_PROBE
+ Introduction:
+    One Tc probe of the parallel k-section search ("-jobs N")
+ -------------------------------------------------------------------*/
+struct TC_PROBE
+{
+    double      _tc         ;
+    long        _candidx    ;//index in the candidates of the discrete search (-1: none)
+    long        _clausenum  ;//# timing clauses
+    int         _status     ;//SAT_SAT/SAT_UNSAT/SAT_UNKNOWN (cancelled or out of budget)
+    bool        _cancelled  ;//made moot by another probe
+    double      _time       ;//wall-clock time of the probe (s)
+    long        _conflicts  ;//# conflicts of the probe
+    vector<int> _model      ;
+};
+/*------------------------------------------------------------------
+ Data Type Name:
+    TC_PROBE_SLOT
+ Introduction:
+    Incremental solver of probe i of every round of the parallel
+    k-section search, kept for the whole search ("-jobs N")
+ -------------------------------------------------------------------*/
+struct TC_PROBE_SLOT
+{
+    SatSolver   *_solver    ;
+    bool        _loaded     ;//DCC/VTA/DCC-leader constraints are in _solver
+    long        _loadednum  ;//# clauses of _tcclausedb in _solver
+    vector< tuple< long, long, int > > _band ;//[begin, end) of _tcclausedb in _solver, activation var
+};
+/*------------------------------------------------------------------
+ Data Type Name:
+    TC_COMPONENT
+ Introduction:
+    One independent component of the CNF ("-components N"): its
+    clauses share no var with the other components, so its optimal
+    Tc is searched on its own (the optimal Tc of the circuit is the
+    largest one of the components)
+ -------------------------------------------------------------------*/
+struct TC_COMPONENT
+{
+    vector< int >   _var        ;//vars of the component (ascending), var i of its solver is _var[i-1]
+    ClauseArena     _constraint ;//DCC/VTA/DCC-leader constraints, latency var definitions, refinement clauses (vars of its solver)
+    vector< long >  _timing     ;//timing clauses (position in the DB, descending critical Tc)
+    double          _besttc     ;//smallest Tc proven SAT (0: none)
+    double          _upbound    ;//Tc range at the end of the Binary search
+    double          _lowbound   ;
+    double          _provenlow  ;//largest Tc proven UNSAT (-1: none)
+    int             _probenum   ;//# SAT calls
+    long            _clausenum  ;//max # timing clauses of a SAT call
+    long            _conflicts  ;
+    double          _time       ;//wall-clock time of the search (s)
+    vector< int >   _model      ;//model of _besttc (vars of its solver)
+};
+/*------------------------------------------------------------------
+ Data Type Name:
+    DC_TYPE
+ Introduction:
+    Duty cycles given by DCCs (and the nominal one), same order as
+    the Sv of VTH_TECH. Index of the aging rate table.
+ -------------------------------------------------------------------*/
+enum DC_TYPE { DCT_NONE = -1, DCT_1, DCT_2, DCT_N, DCT_3, DCT_1_AGE, DCT_2_AGE, DCT_3_AGE, DCT_NUM };
+/*------------------------------------------------------------------
+ Data Type Name:
+    CLK_LATENCY
+ Introduction:
+    Prefix data of the clock path from the root to a node, so that
+    the latency of a clock path without clock gating and inserted
+    buffers is evaluated in O(1) (see calClkLatenByTable)
+ -------------------------------------------------------------------*/
+struct CLK_LATENCY
+{
+    double  _rawsum ;//wire + gate delay from the root to the node (both included)
+    double  _minbuf ;//min wire + gate delay of the buffers from the root (excluded) to the node (9999: none)
+    bool    _plain  ;//no clock gating and no inserted buffer from the root to the node
+};
 /*------------------------------------------------------------------
  Data Type Name:
     Clock Tree
@@ -67,7 +198,7 @@ private:
 	double  _tcAfterAdjust ;
     
     //--- Control of function ----------------------------------------------------------
-    bool    _printClause, _calVTA, _dcc_leader, _bufinsertion ;
+    bool    _printClause, _calVTA, _dcc_leader, _bufinsertion, _extsat, _tcdiscrete ;
     bool    _dc_formulation, _printCP        ;
     
     //--- Timing-related ----------------------------------------------------------------
@@ -90,6 +221,7 @@ private:
     
     //-- Vec-Container ------------------------------------------------------------------
 	vector< CP* > _pathlist;
+	vector< CP* > _timingedge ;//worst path of each (start clock leaf, end clock leaf, path type), see collapseTimingEdge
     
     //-- Map-Container ------------------------------------------------------------------
 	map   < string, CTN* > _ffsink     ;
@@ -102,9 +234,91 @@ private:
     set   < tuple< CTN*, double, int > >    _DccLeaderset ;
     set   < pair< CTN*, CTN* >  >           _setVTALeader ;
     set   < pair< int, int >    >           _setDCC       ;
-	set   < string >  _VTAconstraintlist    ;
-    set   < string >  _dccconstraintlist    ;
-    set   < string >  _timingconstraintlist ;
+	ClauseArena       _VTAconstraintlist    ;
+    ClauseArena       _dccconstraintlist    ;
+    //-- CNF vars of clock nodes: 3 per unmasked node (DCC bit0, DCC bit1, header), -------
+    //-- given in DFS order; masked nodes, the root and FFs have none ------------------
+    vector< int >     _nodevar              ;//first var of each node (by (node number-1)/3, 0: none)
+    vector< CTN* >    _varnode              ;//node of each var triple (by (var-1)/3)
+    //-- Auxiliary CNF vars (numbered after the vars of clock nodes) --------------------
+    long              _cnfauxvarnum         ;
+    vector< tuple< int, vector<int>, int > > _abovevar ;//"DCC (leader) on node or above" var, node vars, same var of the nearest upper node (0: none)
+    map< long, CTN* > _leaderupper          ;//nearest unmasked upper node on the clock paths of critical paths
+    map< long, int >  _leaderabove          ;//"leader on node or above" var
+    long              _timingclausenum      ;//# timing clauses of Tc (prefix of _tcclausedb)
+    ClauseArena       _refineclauselist     ;//clauses blocking visited DCC/Leader deployment
+
+    //-- Timing clause DB ----------------------------------------------------------------
+    vector< TIMING_CLAUSE >  _tcclausedb    ;//sorted by critical Tc (descending)
+    ClauseArena              _tcclausearena ;//literals of the timing clauses (index = position in _tcclausedb once simplified)
+    vector< double >         _tcremovedth   ;//critical Tc of the clauses removed by simplifyTimingClauseDB (descending)
+    double                   _tcdbfloor     ;//DB holds every configuration violated at Tc >= floor
+    ClauseArena              _latencykey    ;//configurations of clock paths (sorted literals of the clause side) with a latency var
+    ClauseArena              _latencydeflist;//"configuration => latency var" (var last), same index as _latencykey
+    bool                     _tcdbready     ;
+    
+    //-- Discrete Tc search ("-tc_search=discrete") --------------------------------------
+    vector< double >         _tccandidate   ;//floor and distinct critical Tc in the Tc range (ascending)
+    long                     _tccandlow     ;//largest UNSAT index (-1: none)
+    long                     _tccandup      ;//smallest SAT index (size: none)
+    long                     _tccandidx     ;//index of the Tc under probing
+    bool                     _tcsearchdone  ;
+    
+    //-- Parallel k-section Tc search ("-jobs N") ---------------------------------------
+    int                      _jobs          ;
+    vector< TC_PROBE >       _tcprobe       ;//probes of the latest round (ascending Tc)
+    vector< TC_PROBE_SLOT >  _tcprobeslot   ;//solver of each probe slot
+    double                   _tcdbtime      ;//time of building the timing clause DB (s), "-jobs N"/"-components N"
+    
+    //-- Independent components searched in parallel ("-components N") ------------------
+    int                      _compjobs      ;//# worker threads (0: off)
+    vector< TC_COMPONENT >   _component     ;//components holding timing clauses come first
+    
+    //-- Clock latency table ------------------------------------------------------------
+    vector< CLK_LATENCY >    _clklaten      ;//by (node number-1)/3
+    double                   _clklatenar    ;//aging rate of a buffer without DCC and header
+    bool                     _clklatenready ;//cleared when clock gating or buffer insertion changes
+    
+    //-- Incremental timing (see initIncrementalTiming) ----------------------------------
+    vector< vector< long > > _nodepath      ;//paths whose clock paths pass through the node (by (node number-1)/3, index in _pathlist)
+    vector< double >         _staslack      ;//slack of each timed path (by index in _pathlist)
+    set< pair< double, long > > _staorder   ;//(slack, path) of the timed paths, worst first
+    set< long >              _staviolation  ;//timed paths with negative slack, in the order of _pathlist
+    bool                     _staupdate, _stadccvta, _staaging, _staset ;//arguments of UpdatePathTiming
+    double                   _statc         ;//Tc of the slacks (changed: re-time every path)
+    bool                     _stacheck      ;//"-sta_check": cross-check every edit with full recomputation
+    long                     _staretimenum  ;//# paths re-timed by edits
+    
+    //-- Parallel timing clause generation ("-threads N") -------------------------------
+    int                      _threads       ;
+    
+    //-- Lazy timing clause generation ("-lazy K") ---------------------------------------
+    long                     _lazyedgenum   ;//K most critical timing edges in the DB first (0: every edge)
+    vector< bool >           _edgeactive    ;//timing edges in the DB (by location in _timingedge)
+
+    //-- SAT engine --------------------------------------------------------------------
+    vector< SatSolver* > _satsolver ;//in-process incremental solvers (one per portfolio configuration)
+    int             _portfolio      ;//# of racing configurations
+    int             _satwinner      ;//configuration answering the latest call
+    long            _satwincount[PORTFOLIO_MAX];
+    long            _satconflictbudget;//conflicts per SAT call (-1: no limit)
+    double          _sattimebudget  ;//seconds per SAT call (0: no limit)
+    long            _tcunknownnum   ;//# Tc probes out of budget (UNKNOWN)
+    double          _tcprovenlow    ;//largest Tc proven UNSAT (-1: none)
+    long            _satloadedrefine;//# clauses of _refineclauselist already in _satsolver
+    double          _satloadedtc    ;//Tc of the latest probe
+    long            _satloadednum   ;//# clauses of _tcclausedb already in _satsolver
+    vector< tuple< long, long, int > > _satband;//[begin, end) of _tcclausedb in _satsolver, activation var
+    int             _satstatus      ;//result of the latest call (SAT_SAT/SAT_UNSAT/-1)
+    vector< int >   _satmodel       ;//model of the latest call
+    vector< int >   _bestmodel      ;//model of the best (SAT) Tc
+    bool            _phasehint      ;//warm start each call with the phases of _phasemodel
+    vector< int >   _phasemodel     ;//latest SAT model
+    long            _satconflictnum ;//# conflicts of the built-in engine
+    //-- UNSAT core ("-unsat_core") ----------------------------------------------------
+    bool            _unsatcoreon    ;
+    double          _unsatcoretc    ;//Tc of the core (-1: none)
+    vector< long >  _unsatcore      ;//critical paths (path number) whose timing clauses are in the core
 	
     //-- HTV ---------------------------------------------------------------------------
     int     _VTH_LIB_cnt    ;
@@ -112,9 +326,8 @@ private:
     double  _baseVthOffset  ;
     vector< VTH_TECH* > _VthTechList ;
     double  _exp            ;
-    double  _nominal_agr[8] ;
-    double  _HTV_agr[8]     ;
-	double  _HTV_fresh      ;
+    vector< double >    _agingratelut   ;//by ( ( Vth lib + 1 )*DCT_NUM + DC type )*2 + aged, see buildAgingRateTable
+    long                _agingrategen   ;//# builds of _agingratelut (drops the per-thread caches of getAgingRate_givDC_givVth)
     
     
     long long int Max_timing_count;
@@ -124,8 +337,53 @@ private:
 	void recordClockPath(char)              ;
 	void checkFirstChildrenFormRoot(void)   ;
 	void initTcBound(void)                  ;
-	void genDccConstraintClause(vector<vector<long> > *);
-	void genClauseByDccVTA(CTN*, string *, double, int);
+	int  genAboveVar(CTN*, bool, map<long, CTN*>&, map<long, int>&, ClauseArena&, long&);
+	void genAtMostOneOnClockPath(const vector<CTN*>&, bool, map<long, CTN*>&, map<long, int>&, ClauseArena&, long&);
+	void buildCnfVarMap(void)               ;
+	void buildAgingRateTable(void)          ;
+	DC_TYPE getDCType(double)               ;
+	double getAgingRate_givDCType_givVth(DC_TYPE type, int LibIndex, bool caging) { return _agingratelut[ ( ( LibIndex + 1 )*DCT_NUM + type )*2 + caging ] ; }
+	void buildNodePathIndex(void)           ;
+	void retimePath(long)                   ;
+	void checkIncrementalTiming(void)       ;
+	bool calClkLatenByTable(const vector<CTN*>&, double, CTN*, int, CTN*, bool, double&, double&, int&);
+	void addNodeLiteral(vector<int>&, CTN*, int, bool);
+	int  newCnfAuxVar(void)                 ;
+	void evalCnfAuxVar(bool *)              ;
+	void genClauseByDccVTA(CTN*, vector<int> *, double, int);
+	void buildTimingClauseDB(void)          ;
+	void simplifyTimingClauseDB(void)       ;
+	void genTimingClause(CriticalPath *)    ;
+	void genTimingClauseByThread(const vector<CP*>&, vector<TIMING_CLAUSE_BUF>&, atomic<long>&);
+	void sweepPathTimingByThread(TIMING_SWEEP &);
+	bool lazyRefine(const vector<int>&)     ;
+	void buildTcComponent(void)             ;
+	void searchTcComponent(TC_COMPONENT &)  ;
+	void getComponentClause(const TC_COMPONENT&, const int *, long, vector<int>&);
+	void searchTcComponentByThread(atomic<long>&);
+	void recordTimingClause(vector<int> &, long, double, double, string &, long);
+	void encodeLatencyVar(void)             ;
+	bool tcDiscreteSearch(void)             ;
+	vector<int> loadClauseToSolver(void)    ;
+	void clearSolver(void)                  ;
+	void addClauseToSolver(const int *, long);
+	void addClauseToSolver(const vector<int> &clause)    { addClauseToSolver( clause.data(), (long)clause.size() ); }
+	void addConstraintToSolver(SatSolver *);
+	int  newSolverVar(void)                 ;
+	long minimizeCardinality(const vector<int>&, vector<int>&, vector<int>&, long&);
+	vector<int> genTotalizer(const vector<int>&, long, long, long);
+	long countTrueLiteral(const vector<int>&, const vector<int>&);
+	int  solveByPortfolio(const vector<int>&, vector<int>&);
+	int  runMinisat(string, string, vector<int>&);
+	void loadTimingBand(long, long)         ;
+	long getTimingClausePrefix(double)      ;
+	void genTcProbe(void)                   ;
+	vector<int> loadTcProbeSlot(TC_PROBE_SLOT&, long);
+	vector<int> loadSlotTimingClause(TC_PROBE_SLOT&, long, long, long, const function<void(long, vector<int>&)>&);
+	void clearTcProbeSlot(void)             ;
+	void solveTcProbe(long, mutex&)         ;
+	int  readMinisatOutput(string, vector<int>&);
+	void decodeDccVTAFromModel(const vector<int>&);
 	void deleteClockTree(void)              ;
 	//-- Dumper ------------------------------------------------------------------
 	void dumpDccListToFile(void)            ;
@@ -148,7 +406,10 @@ public:
 			   _clktreeroot(nullptr), _firstchildrennode(nullptr), _mostcriticalpath(nullptr),
 			   _timingreport(""), _timingreportfilename(""), _timingreportloc(""), _timingreportdesign(""),
 			   _cgfilename(""), _outputdir(""), _tcAfterAdjust(0), _printClause(false), _baseVthOffset(0), _exp(0.2),  _usingSeniorAging(false),
-               _printClkNode(false), _calVTA(false), _dcc_leader(false), _dc_formulation(false), Max_timing_count(0), refine_time(100), _dcc_constraint_ctr(0), _leader_constraint_ctr(0), _printCP(false), _program_ctl(0), DC_1(0.2), DC_2(0.4), DC_3(0.8), DC_N(0.5), DC_1_age(0.22), DC_2_age(0.44), DC_3_age(0.83), DC_N_age(0.5) {}
+               _printClkNode(false), _calVTA(false), _dcc_leader(false), _dc_formulation(false), Max_timing_count(0), refine_time(100), _dcc_constraint_ctr(0), _leader_constraint_ctr(0), _printCP(false), _program_ctl(0), DC_1(0.2), DC_2(0.4), DC_3(0.8), DC_N(0.5), DC_1_age(0.22), DC_2_age(0.44), DC_3_age(0.83), DC_N_age(0.5),
+               _extsat(false), _portfolio(1), _satwinner(-1), _satwincount(), _satconflictbudget(-1), _sattimebudget(0), _tcunknownnum(0), _tcprovenlow(-1), _satloadedrefine(0), _satloadedtc(0), _satloadednum(0), _timingclausenum(0), _satstatus(-1), _phasehint(true), _satconflictnum(0), _unsatcoreon(false), _unsatcoretc(-1),
+               _tcdbfloor(0), _tcdbready(false), _tcdiscrete(false), _tccandlow(-1), _tccandup(0), _tccandidx(-1), _tcsearchdone(false), _jobs(1), _tcdbtime(0), _compjobs(0), _threads(1), _lazyedgenum(0), _cnfauxvarnum(0), _agingrategen(0), _clklatenar(1), _clklatenready(false),
+               _staupdate(false), _stadccvta(true), _staaging(true), _staset(false), _statc(0), _stacheck(false), _staretimenum(0) {}
 	//-Destructor------------------------------------------------------------------
     ~ClockTree(void);
 	
@@ -187,6 +448,10 @@ public:
 	long    getFFToFFNumber(void)                   { return _fftoffnum         ; }
 	long    getFFToPoNumber(void)                   { return _fftoponum         ; }
 	long    getTotalNodeNumber(void)                { return _totalnodenum      ; }
+	long    getNodeVarNumber(void)                  { return (long)_varnode.size() * 3 ; }
+	long    getCnfVarNumber(void)                   { return getNodeVarNumber() + _cnfauxvarnum ; }
+	int     getNodeVar(CTN *node)                   { long id = ( node->getNodeNumber() - 1 ) / 3 ; return ( id < (long)_nodevar.size() ) ? _nodevar[id] : 0 ; }
+	CTN*    getVarNode(long var)                    { return ( var >= 1 && var <= getNodeVarNumber() ) ? _varnode[(var - 1) / 3] : nullptr ; }
 	long    getTotalFFNumber(void)                  { return _ffsink.size()     ; }
 	long    getTotalBufferNumber(void)              { return _buflist.size()    ; }
 	long    getTotalClockGatingNumber(void)         { return _cglist.size()     ; }
@@ -210,6 +475,28 @@ public:
 	double  getTc(void)                             { return _tc                ; }
 	double  getTcUpperBound(void)                   { return _tcupbound         ; }
 	double  getTcLowerBound(void)                   { return _tclowbound        ; }
+    long    getTcCandidateIndex(void)               { return _tccandidx         ; }
+    long    getTcCandidateNumber(void)              { return (long)_tccandidate.size(); }
+    int     getJobNumber(void)                      { return _jobs              ; }
+    double  getTimingClauseDBTime(void)             { return _tcdbtime          ; }
+    int     getComponentJobNumber(void)             { return _compjobs          ; }
+    vector< TC_COMPONENT >& getTcComponentList(void){ return _component         ; }
+    int     getThreadNumber(void)                   { return _threads           ; }
+    long    getLazyEdgeNumber(void)                 { return _lazyedgenum       ; }
+    int     getPortfolioNumber(void)                { return _portfolio         ; }
+    long    getPortfolioWinNumber(int c)            { return _satwincount[c]    ; }
+    string  getPortfolioName(int)                   ;
+    int     getSatStatus(void)                      { return _satstatus         ; }
+    long    getSatUnknownNumber(void)               { return _tcunknownnum      ; }
+    double  getProvenUnsatTc(void)                  { return _tcprovenlow       ; }
+    const vector<long>& getUnsatCore(void)          { return _unsatcore         ; }
+    long    getSatConflictNumber(void)              { return _satconflictnum    ; }
+    bool    ifPhaseHint(void)                       { return _phasehint         ; }
+    bool    ifUnsatCore(void)                       { return _unsatcoreon       ; }
+    double  getUnsatCoreTc(void)                    { return _unsatcoretc       ; }
+    bool    ifSatBudget(void)                       { return ( _satconflictbudget >= 0 || _sattimebudget > 0 ); }
+    string  getSatWinner(void)                      { return ( _satwinner < 0 ) ? "N/A" : getPortfolioName(_satwinner); }
+    const vector<TC_PROBE>& getTcProbeList(void)    { return _tcprobe           ; }
     double  getBaseVthOffset(void)                  { return _baseVthOffset     ; }
 	string  getTimingReportFileName(void)           { return _timingreportfilename; }
 	string  getTimingReportLocation(void)           { return _timingreportloc   ; }
@@ -219,6 +506,7 @@ public:
 	ClockTreeNode   *getFirstChildrenNode(void)     { return _firstchildrennode ; }
 	CriticalPath    *getMostCriticalPath(void)      { return _mostcriticalpath  ; }
 	vector<CP*>& getPathList(void)       { return _pathlist          ; }
+	vector<CP*>& getTimingEdgeList(void) { return _timingedge        ; }
     vector<VTH_TECH*>&      getLibList(void)        { return _VthTechList       ; }
     set< pair<CTN*,CTN*> >& getVTASet(void) { return _setVTALeader ; }
     set< pair<int,int> >& getDCCSet(void) { return _setDCC ; }
@@ -236,6 +524,9 @@ public:
 	bool ifDumpClockGating(void)                    { return _dumpcg            ; }
 	bool ifDumpBufferInsertion(void)                { return _dumpbufins        ; }
     bool ifdoVTA(void)                              { return _doVTA             ; }
+    bool ifExternalSat(void)                        { return _extsat            ; }
+    bool ifTcDiscrete(void)                         { return _tcdiscrete        ; }
+    bool ifTcSearchDone(void)                       { return _tcsearchdone      ; }
     //---Setting ----------------------------------------------------------------
 	int     checkParameter(int, char **, string *);//read parameter from cmd line
     void    readParameter(void);                   //read parameter from text file
@@ -273,13 +564,12 @@ public:
     //---DCC-Leader Constraint ----------------------------------------------------
     //Constraints: Leader must be put in the downstream of dcc
     void    DCCLeaderConstraint(void);
-    void    DCCLeaderConstraintFFtoFF( CP* );
-    void    DCCLeaderConstraintPItoFF( CP* );
-    void    DCCLeaderConstraintFFtoPO( CP* );
     
     
     
 	void    genDccPlacementCandidate(void);
+	void    collapseTimingEdge(void);
+	void    buildClockLatencyTable(void);
     
     //---Timing Constraint---------------------------------------------------------
 	long    timingConstraint( void );
@@ -293,15 +583,15 @@ public:
     void    timingConstraint_givDCC_doVTA(  CP*, double, double, CTN*, CTN*, bool aging = 1);
     void    timingConstraint_givDCC_ndoVTA( CP*, double, double, CTN*, CTN*, bool aging = 1);
     //---Clause ------------------------------------------------------------------
-    void    writeClause_givDCC( string &clause, CTN* node, double DCCType  );
-    void    writeClause_givVTA( string &clause, CTN* node, int    LibIndex );
+    void    writeClause_givDCC( vector<int> &clause, CTN* node, double DCCType  );
+    void    writeClause_givVTA( vector<int> &clause, CTN* node, int    LibIndex );
     //---VTA-related -------------------------------------------------------------
 	double  getAgingRate_givDC_givVth( double DC, int LibIndex, bool initial = 0, bool cAging = 1 ) ;
     //---Timing-related ----------------------------------------------------------
     void    adjustOriginTc( void )        ;
     void    updateAllPathTiming( void )   ;
     void    tcRecheck( void )             ;
-    double  calClkLaten_givDcc_givVTA   (vector<CTN*> path, double DC, CTN* Loc1, int Lib, CTN* Loc2, bool aging=1, bool set=0, bool cPV=0 );
+    double  calClkLaten_givDcc_givVTA   (const vector<CTN*> &path, double DC, CTN* Loc1, int Lib, CTN* Loc2, bool aging=1, bool set=0, bool cPV=0 );
     
     //---Dumper ------------------------------------------------------------------
 	void    dumpClauseToCnfFile(void)      ;
@@ -309,6 +599,13 @@ public:
     void    dumpToFile(void)               ;
     void    dumpDccVTALeaderToFile(void)   ;
     double  UpdatePathTiming(CP*,bool update = true, bool DCCVTA = true, bool aging = true, bool set = false, bool cPV = false );
+    double  sweepPathTiming(bool update = true, bool DCCVTA = true, bool aging = true, bool cPV = false, CP **worst = nullptr, vector<double> *slacks = nullptr);
+    //---Incremental timing ------------------------------------------------------
+    void    initIncrementalTiming(bool update, bool DCCVTA, bool aging, bool set = false);
+    void    retimeClockNode(CTN*)         ;
+    double  getWorstSlack(CP **path = nullptr);
+    CP*     getFirstViolatingPath(bool withFFtoPO = true);
+    const set<long>& getViolatingPathList(void) { return _staviolation ; }
     
 	//---Printer --------------------------------------------------------------------
 	void    printDccList(void)          ;
@@ -341,11 +638,19 @@ public:
     bool    DoOtherFunction( void )             ;
     void    execMinisat( void )                 ;
     bool    tcBinarySearch( void )              ;
+    void    initTcCandidate( void )             ;
+    void    execMinisatParallel( void )         ;
+    bool    tcKSectionSearch( void )            ;
+    void    execMinisatByComponent( void )      ;
+    void    tcAnytimeFallback( void )           ;
+    bool    extractUnsatCore( void )            ;
     void    printFinalResult( void )            ;
+    void    printUnsatCore( void )              ;
     long    calVTABufferCount(       bool=0 )   ;
     void    calVTABufferCountByFile( void   )   ;
     bool    SolveCNFbyMiniSAT( double, bool=0 ) ;
     void    EncodeDccLeader( double )           ;
+    bool    minimizeDccLeaderBySat( void )      ;
     CTN*    searchClockTreeNode( string )       ;
     CTN*    searchClockTreeNode( long   )       ;
 	void    bufinsertionbyfile();
@@ -237,9 +237,25 @@ void ClockTree::checkCNF()
         return                ;
     }
         
-    long nodenum = _totalnodenum*3;
-    bool *bolarray = new bool [ nodenum + 1000 ]   ;
-    for( int i = 0 ; i <= nodenum; i++ ) bolarray[i] = false;
+    //-- Auxiliary vars of the constraints are set from the deployment ----------
+    if( this->_abovevar.empty() )
+    {
+        this->VTAConstraint();
+        this->dccConstraint();
+        this->DCCLeaderConstraint();
+    }
+    long nodenum = this->getCnfVarNumber();
+    bool correct = true ;
+    //-- Read CNF (latency vars of the timing clauses may follow the known vars) ---
+    vector< vector<string> > vCNF ;
+    long maxvar = nodenum ;
+    while( getline( fCNF, line ) )
+    {
+        vCNF.push_back( stringSplit( line, " " ) );
+        for( auto const& Var: vCNF.back() ) maxvar = max( maxvar, (long)abs( stoi( Var ) ) );
+    }
+    bool *bolarray = new bool [ maxvar + 1000 ]   ;
+    for( long i = 0 ; i <= maxvar; i++ ) bolarray[i] = false;
     //-- Read DCC/VTA Deployment ------------------------------------------------------
     getline( fDCCVTA, line )        ;
     string          tc              ;
@@ -259,6 +275,17 @@ void ClockTree::checkCNF()
             printf( RED"[Error] " RESET"Can't find clock node with id = %ld\n", BufID ) ;
             return ;
         }
+        long nodeid = BufID ;
+        BufID = this->getNodeVar( buffer ) ;
+        if( BufID == 0 )//masked node, the root or FF: no DCC/VTA var
+        {
+            if( ( BufDCC != 0.5 && BufDCC != 0 && BufDCC != -1 ) || BufVthLib != -1 )
+            {
+                printf( RED"[Violation]" RST"Clock node %ld can't have DCC/VTA !\n", nodeid ) ;
+                correct = false ;
+            }
+            continue ;
+        }
         //-- Set Boolean Vars of DCC Types -------------------------------------------
         if( BufDCC == 0.8 ){
             bolarray[ BufID ] = bolarray[ BufID + 1 ] = true ;
@@ -279,19 +306,24 @@ void ClockTree::checkCNF()
             bolarray[ BufID + 2 ] = true  ;
     }
     fDCCVTA.close();
-    //-- Read CNF ------------------------------------------------------------------
-    vector< string > vClause;
-    bool correct = true ;
-    while( getline( fCNF, line ) )
+    this->evalCnfAuxVar( bolarray );
+    //-- Unknown latency vars are set by their definitions "configuration => L" ----
+    for( auto &vClause: vCNF )
+    {
+        if( clauseJudgement( vClause, bolarray ) ) continue ;
+        for( auto const& Var: vClause )
+            if( stoi( Var ) > nodenum ) { bolarray[ stoi( Var ) ] = true ; break ; }
+    }
+    //-- Check CNF -----------------------------------------------------------------
+    for( auto &vClause: vCNF )
     {
-        vClause = stringSplit( line, " " ) ;
         if( clauseJudgement( vClause, bolarray ) == false )
         {
+            line = "" ;
+            for( auto const& Var: vClause ) line += Var + " " ;
             printf( RED"[Violation]" RST"Clause %s violated !\n", line.c_str() ) ;
             correct = false ;
         }
-        
-        vClause.clear();
     }
     free( bolarray );
     if( correct )
@@ -412,54 +444,51 @@ void ClockTree::minimizeLeader(void)
         node.second->setVTAType( -1 );
     }
     this->_tc = this->_besttc;
+    this->initIncrementalTiming( true, true, true );
     // Greedy minimization
     while( true )
     {
         if( redun_leader.empty()) break;
-        bool endflag = 1, findstartpath = 1;
+        bool findstartpath = 1;
         // Reserve one of the rest of DCCs above if one of critical paths occurs timing violation
-        for(auto const& path: this->_pathlist)
+        CP *path = this->getFirstViolatingPath();
+        if( path == nullptr ) break;
+        for( leaderitr = redun_leader.begin(); leaderitr != redun_leader.end(); )
         {
-            if((path->getPathType() != PItoFF) && (path->getPathType() != FFtoPO) && (path->getPathType() != FFtoFF)) continue;
-            // Assess if the critical path occurs timing violation in the DCC deployment
-            double slack = this->UpdatePathTiming( path, true, true, true ) ;
-            
-            if( slack < 0 )
+            if( leaderitr->second->getIfPlaceHeader() )
             {
-                endflag = 0;
-                for( auto const& node: redun_leader )
-                    if( node.second->getIfPlaceHeader() )
-                    {
-                        node.second->setVTAType(0);
-                        redun_leader.erase(node.first);
-                    }
-                // Reserve the DCC locate in the clock path of endpoint
-                for(auto const& node: path->getEndPonitClkPath())
-                {
-                    leaderitr = redun_leader.find(node->getGateData()->getGateName());
-                    if(( leaderitr != redun_leader.end()) && !leaderitr->second->getIfPlaceHeader())
-                    {
-                        leaderitr->second->setIfPlaceHeader(1);
-                        leaderitr->second->setVTAType(0);
-                        findstartpath = 0;
-                    }
-                }
-                // Reserve the DCC locate in the clock path of startpoint
-                if(findstartpath)
-                {
-                    for(auto const& node: path->getStartPonitClkPath())
-                    {
-                        leaderitr = redun_leader.find(node->getGateData()->getGateName());
-                        if((leaderitr != redun_leader.end()) && !leaderitr->second->getIfPlaceHeader()){
-                            leaderitr->second->setIfPlaceHeader(1);
-                            leaderitr->second->setVTAType(0);
-                        }
-                    }
+                leaderitr->second->setVTAType(0);
+                this->retimeClockNode( leaderitr->second );
+                leaderitr = redun_leader.erase(leaderitr);
+            }
+            else
+                leaderitr++;
+        }
+        // Reserve the DCC locate in the clock path of endpoint
+        for(auto const& node: path->getEndPonitClkPath())
+        {
+            leaderitr = redun_leader.find(node->getGateData()->getGateName());
+            if(( leaderitr != redun_leader.end()) && !leaderitr->second->getIfPlaceHeader())
+            {
+                leaderitr->second->setIfPlaceHeader(1);
+                leaderitr->second->setVTAType(0);
+                this->retimeClockNode( leaderitr->second );
+                findstartpath = 0;
+            }
+        }
+        // Reserve the DCC locate in the clock path of startpoint
+        if(findstartpath)
+        {
+            for(auto const& node: path->getStartPonitClkPath())
+            {
+                leaderitr = redun_leader.find(node->getGateData()->getGateName());
+                if((leaderitr != redun_leader.end()) && !leaderitr->second->getIfPlaceHeader()){
+                    leaderitr->second->setIfPlaceHeader(1);
+                    leaderitr->second->setVTAType(0);
+                    this->retimeClockNode( leaderitr->second );
                 }
-                break;
             }
         }
-        if( endflag ) break;
     }
     
     for(auto const& node: this->_VTAlist )
@@ -476,136 +505,78 @@ void ClockTree::minimizeLeader(void)
 
 bool ClockTree::SolveCNFbyMiniSAT( double tc, bool ifDeploy )
 {
-    string cnfinput = this->_outputdir + "cnfinput_" + to_string( tc );
-    // MiniSat output file
-    string cnfoutput = this->_outputdir + "cnfoutput_" + to_string( tc );
-    if( !isDirectoryExist(this->_outputdir) ) mkdir(this->_outputdir.c_str(), 0775);
-    //----- Call MiniSAT -----------------------------------------------
-    if( isFileExist(cnfinput) )
+    vector<int> model ;
+    int status = -1 ;
+    //----- Built-in SAT engine (clauses of "tc" + refinement clauses) ------------
+    if( !this->ifExternalSat() )
     {
-        pid_t childpid = fork();
-        if( childpid == -1 )    cerr << RED"[Error]: Cannot fork child process!\033[0m\n";
-        else if( childpid == 0 )
-        {
-            // Child process
-            string minisatfile = this->_outputdir + "minisat_output";
-            int fp = open(minisatfile.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0664);
-            if( fp == -1) cerr << RED"[Error]: Cannot dump the executive output of minisat!\033[0m\n";
-            else
-            {
-                dup2(fp, STDOUT_FILENO);
-                dup2(fp, STDERR_FILENO);
-                close(fp);
-            }
-            if( execlp("./minisat", "./minisat", cnfinput.c_str(), cnfoutput.c_str(), (char *)0) == -1 )
-            {
-                cerr << RED"[Error]: Cannot execute minisat!\033[0m\n";
-                this->_minisatexecnum--;
-            }
-            exit(0);
-        }
-        else
+        double curtc = this->_tc ;
+        this->_tc = tc ;
+        vector<int> assumps = this->loadClauseToSolver();
+        this->_minisatexecnum++;
+        status = this->solveByPortfolio( assumps, model );
+        while( status == SAT_SAT && this->lazyRefine( model ) )//"-lazy K"
         {
-            // Parent process
-            int exitstatus;
-            waitpid(childpid, &exitstatus, 0);
+            assumps = this->loadClauseToSolver();
+            this->_minisatexecnum++;
+            status = this->solveByPortfolio( assumps, model );
         }
+        this->_tc = curtc ;
     }
-    else return 0;
-        
-    //----- See result from the output returned from MiniSAT -----------------------------------------------
-    fstream cnffile;
-    string line;
-    if( !isFileExist(cnfoutput) ) return false;
-    
-    cnffile.open(cnfoutput, ios::in);
-    if( !cnffile.is_open() )
+    //----- Call MiniSAT -----------------------------------------------
+    else
     {
-        cerr << RED"\t[Error]: Cannot open " << cnfoutput << "\033[0m\n";
-        cnffile.close();
-        return false;
+        string cnfinput = this->_outputdir + "cnfinput_" + to_string( tc );
+        // MiniSat output file
+        string cnfoutput = this->_outputdir + "cnfoutput_" + to_string( tc );
+        if( !isDirectoryExist(this->_outputdir) ) mkdir(this->_outputdir.c_str(), 0775);
+        if( !isFileExist(cnfinput) ) return 0;
+        status = this->runMinisat( cnfinput, cnfoutput, model );
     }
-    getline(cnffile, line);
     
     //------ Check SAT/UNSAT --------------------------------------------------------------
     //If SAT, decoding the DCC deployment and leader selection
-    if((line.size() == 5) && (line.find("UNSAT") != string::npos))    return false ;
-    else if((line.size() == 3) && (line.find("SAT") != string::npos))
+    if( status != SAT_SAT ) return false ;
+    if( !ifDeploy ) return true ;
+    
+    //-- Init -------------------------------------------------------------------------
+    this->_dcclist.clear();
+    this->_VTAlist.clear();
+    for( auto const& node: this->_buflist )
     {
-        if( !ifDeploy ) return true ;
-        
-        //-- Init -------------------------------------------------------------------------
-        this->_dcclist.clear();
-        this->_VTAlist.clear();
-        for( auto const& node: this->_buflist )
-        {
-            node.second->setIfPlaceDcc(0)   ;
-            node.second->setDccType(0) ;
-            node.second->setIfPlaceHeader(0);
-            node.second->setVTAType(-1);
-        }
-        getline(cnffile, line) ;
-        vector<string> strspl = stringSplit(line, " ");
-        //------ Clk Node Iteration ---------------------------------------------------
-        for( long loop = 0; ; loop += 3 /*2*/ )
-        {
-            if( stoi( strspl[loop] ) == 0 ) break ;
-            
-            //-- Put DCC --------------------------------------------------------------
-            if( ( stoi(strspl.at(loop)) > 0) || (stoi(strspl.at(loop + 1)) > 0)  )
-            {
-                CTN *findnode = this->searchClockTreeNode(abs(stoi(strspl.at(loop))));
-                    
-                if( findnode != nullptr )
-                {
-                    findnode->setIfPlaceDcc(1)      ;
-                    findnode->setDccType(stoi(strspl.at(loop)), stoi(strspl.at(loop + 1)),this->DC_1, this->DC_2, this->DC_N, this->DC_3 );
-                    this->_dcclist.insert(pair<string, CTN *> (findnode->getGateData()->getGateName(), findnode));
-                }
-                else
-                    cerr << "[Error] Clock node mismatch, when decoing DCC and Solution exist!\n" ;
-            }
-            //-- Put Header ------------------------------------------------------------
-            if( stoi(strspl.at(loop+2)) > 0 )
-            {
-                CTN *findnode = this->searchClockTreeNode(abs(stoi(strspl.at(loop))));
-                    
-                if( findnode != nullptr )
-                {
-                    findnode->setIfPlaceHeader(1);
-                    findnode->setVTAType(0);
-                    this->_VTAlist.insert(pair<string, CTN *> (findnode->getGateData()->getGateName(), findnode));
-                }
-                else
-                    cerr << "[Error] Clock node mismatch, when decoing VTA and Solution exist!\n" ;
-            }
-        }
-        cnffile.close() ;
-        double minslack = 9999;
-        for( auto const& path: this->_pathlist )
-        {
-            if((path->getPathType() != PItoFF) && (path->getPathType() != FFtoPO) && (path->getPathType() != FFtoFF))
-                continue;
-            // Update timing information
-            double slack = this->UpdatePathTiming( path, true, true, true );
-                
-            if( slack < minslack )
-            {
-                this->_mostcriticalpath = path;
-                minslack = min( slack, minslack );
-            }
-            if( slack < 0 )
-                printf( RED"[Error] path(%ld) slk = %f \n", path->getPathNum(), path->getSlack() );
-        }
-        
-        
-        return true ;
-    }//elif SAT
-    return false;
+        node.second->setIfPlaceDcc(0)   ;
+        node.second->setDccType(0) ;
+        node.second->setIfPlaceHeader(0);
+        node.second->setVTAType(-1);
+    }
+    this->decodeDccVTAFromModel( model );
+    vector<double> slacks ;
+    this->sweepPathTiming( true, true, true, false, &this->_mostcriticalpath, &slacks );
+    for( long loop = 0; loop < (long)this->_pathlist.size(); loop++ )
+        if( slacks[loop] < 0 )
+            printf( RED"[Error] path(%ld) slk = %f \n", this->_pathlist[loop]->getPathNum(), this->_pathlist[loop]->getSlack() );
+    return true ;
 }
 
 void ClockTree::EncodeDccLeader( double tc )
 {
+    //------- Encding --------------------
+    vector<int> clause ;
+    for( auto const& node: this->_buflist )
+    {
+        if( node.second->getIfPlaceHeader() || node.second->ifPlacedDcc() )
+        {
+            writeClause_givDCC( clause, node.second, node.second->getDccType() );
+            writeClause_givVTA( clause, node.second, node.second->getVTAType() );
+        }
+    }
+    //------- Built-in SAT engine keeps it in memory -----
+    if( !this->ifExternalSat() )
+    {
+        this->_refineclauselist.insert( clause );
+        return ;
+    }
+    
     fstream cnffile ;
     string cnfinput = this->_outputdir + "cnfinput_" + to_string( tc );
     if( !isDirectoryExist(this->_outputdir) )
@@ -620,17 +591,7 @@ void ClockTree::EncodeDccLeader( double tc )
             cnffile.close();
             return;
         }
-        //------- Encding --------------------
-        string clause = "";
-        for( auto const& node: this->_buflist )
-        {
-            if( node.second->getIfPlaceHeader() || node.second->ifPlacedDcc() )
-            {
-                writeClause_givDCC( clause, node.second, node.second->getDccType() );
-                writeClause_givVTA( clause, node.second, node.second->getVTAType() );
-            }
-        }
-        cnffile << clause << "0 \n" ;
+        cnffile << ClauseArena::toString( clause ) << " \n" ;
         cnffile.close();
     }
     else
@@ -706,6 +667,135 @@ void ClockTree::minimizeLeader2( double tc )
     calVTABufferCount(true);
 }
 
+/*------------------------------------------------------------------------------------
+ FuncName:
+    minimizeDccLeaderBySat
+ Introduction:
+    "-mindcc": minimum # of DCCs, then minimum # of leaders (headers) under it, at
+    the optimal Tc. Indicator vars of DCC nodes and the header vars are counted by
+    totalizers in the solver of the search, and the bound "count <= best - 1" is
+    tightened by assumptions until UNSAT (or out of budget), so learnt clauses are
+    kept from call to call. The model of the optimum replaces _bestmodel.
+    Return true if a model with fewer DCCs/leaders is found
+ -------------------------------------------------------------------------------------*/
+bool ClockTree::minimizeDccLeaderBySat()
+{
+    if( !this->_mindccplace || this->_bestmodel.empty() ) return false ;
+    if( this->_placedcc == false && this->ifdoVTA() == false ) return false ;
+    
+    double curtc = this->_tc ;
+    this->_tc = this->_besttc ;
+    vector<int> assumps = this->loadClauseToSolver();
+    this->_tc = curtc ;
+    
+    //-- Objectives: DCC node (dcc <-> either DCC var set) and header var of each node ---
+    vector<int> dccvar, headervar ;
+    long  dccnum = 0, headernum = 0 ;
+    for( long var = 1; var + 2 <= this->getNodeVarNumber(); var += 3 )
+    {
+        if( this->_placedcc )
+        {
+            int dcc = this->newSolverVar();
+            this->addClauseToSolver( { -(int)var      , dcc } );
+            this->addClauseToSolver( { -(int)(var + 1), dcc } );
+            this->addClauseToSolver( {  (int)var, (int)(var + 1), -dcc } );
+            dccvar.push_back( dcc );
+            if( var + 1 <= (long)this->_bestmodel.size() && ( this->_bestmodel[var - 1] > 0 || this->_bestmodel[var] > 0 ) ) dccnum++ ;
+        }
+        if( this->ifdoVTA() )
+        {
+            headervar.push_back( (int)( var + 2 ) );
+            if( var + 2 <= (long)this->_bestmodel.size() && this->_bestmodel[var + 1] > 0 ) headernum++ ;
+        }
+    }
+    //-- Model with the indicator vars, warm started from the deployment of the search ---
+    vector<int> model ;
+    long  calls   = 1 ;
+    this->_phasemodel = this->_bestmodel ;
+    for( auto solver: this->_satsolver ) solver->setPhase( this->_phasemodel );
+    if( this->solveByPortfolio( assumps, model ) != SAT_SAT )
+    {
+        this->_minisatexecnum += calls ;
+        return false ;
+    }
+    long  mindcc  = this->minimizeCardinality( dccvar   , assumps, model, calls );
+    long  minhdr  = this->minimizeCardinality( headervar, assumps, model, calls );
+    this->_minisatexecnum += calls ;
+    //-- "-lazy K": minimize again if the optimum violates a timing edge not in the DB
+    this->_tc = this->_besttc ;
+    bool refined = this->lazyRefine( model );
+    this->_tc = curtc ;
+    if( refined ) return this->minimizeDccLeaderBySat();
+    printf( YELLOW"\t[--Min DCC/Leader-] " RESET"DCC # %ld -> %ld, leader # %ld -> %ld (%ld SAT calls)\n", dccnum, mindcc, headernum, minhdr, calls );
+    if( mindcc == dccnum && minhdr == headernum ) return false ;
+    this->_bestmodel = model ;
+    return true ;
+}
+
+/*------------------------------------------------------------------------------------
+ FuncName:
+    minimizeCardinality
+ Introduction:
+    Minimize the # of true "lits" starting from "model": build a totalizer capped
+    at the current count and assume its output "count >= best" false until UNSAT.
+    The bound of the optimum is appended to "assumps" (for the next objective),
+    "model" is the model of the optimum, and "calls" counts the SAT calls.
+    Return the minimum count (the best one found if out of budget)
+ -------------------------------------------------------------------------------------*/
+long ClockTree::minimizeCardinality( const vector<int> &lits, vector<int> &assumps, vector<int> &model, long &calls )
+{
+    long best = this->countTrueLiteral( lits, model );
+    if( best == 0 ) return 0 ;
+    vector<int> count = this->genTotalizer( lits, 0, (long)lits.size(), best );
+    while( best > 0 )
+    {
+        vector<int> bound = assumps, newmodel ;
+        bound.push_back( -count[best - 1] );//count <= best - 1
+        calls++ ;
+        if( this->solveByPortfolio( bound, newmodel ) != SAT_SAT ) break ;
+        model = newmodel ;
+        best  = this->countTrueLiteral( lits, model );
+    }
+    if( best < (long)count.size() ) assumps.push_back( -count[best] );//count <= best
+    return best ;
+}
+
+/*------------------------------------------------------------------------------------
+ FuncName:
+    genTotalizer
+ Introduction:
+    Totalizer of lits[begin, end) capped at "cap": output k-1 is implied by at
+    least k true inputs (k = cap also stands for more than cap)
+ -------------------------------------------------------------------------------------*/
+vector<int> ClockTree::genTotalizer( const vector<int> &lits, long begin, long end, long cap )
+{
+    if( end - begin == 1 ) return vector<int>( 1, lits[begin] );
+    long mid = ( begin + end ) / 2 ;
+    vector<int> left  = this->genTotalizer( lits, begin, mid, cap );
+    vector<int> right = this->genTotalizer( lits, mid  , end, cap );
+    vector<int> sum ;
+    for( long k = 0; k < min( (long)( left.size() + right.size() ), cap ); k++ ) sum.push_back( this->newSolverVar() );
+    for( long i = 0; i <= (long)left.size(); i++ )
+        for( long j = 0; j <= (long)right.size(); j++ )
+        {
+            if( i + j == 0 ) continue ;
+            vector<int> clause ;
+            if( i > 0 ) clause.push_back( -left[i - 1]  );
+            if( j > 0 ) clause.push_back( -right[j - 1] );
+            clause.push_back( sum[ min( i + j, (long)sum.size() ) - 1 ] );
+            this->addClauseToSolver( clause );
+        }
+    return sum ;
+}
+
+long ClockTree::countTrueLiteral( const vector<int> &lits, const vector<int> &model )
+{
+    long count = 0 ;
+    for( auto lit: lits )
+        if( abs(lit) <= (long)model.size() && model[abs(lit) - 1] == lit ) count++ ;
+    return count ;
+}
+
 void ClockTree::printFinalResult()
 {
     chrono::system_clock::time_point nowtime = chrono::system_clock::now();
@@ -739,15 +829,86 @@ void ClockTree::printFinalResult()
     cout << " -> " << this->getMostCriticalPath()->getEndPointName() << ")\n";
     cout << "\t*** Minimal slack                  : " << this->getMostCriticalPath()->getSlack() << "\n";
     cout << "\t*** Optimal tc                     : \033[36m" << this->getBestTc() << "\033[0m\n";
+    if( this->ifSatBudget() || this->getSatUnknownNumber() > 0 )
+    {
+        //-- Anytime result: best proven SAT Tc and the largest proven UNSAT Tc ---------
+        cout << "\t*** # of UNKNOWN Tc probes         : " << this->getSatUnknownNumber() << "\n";
+        if( this->getProvenUnsatTc() < 0 )  cout << "\t*** Certified Tc gap               : N/A (no Tc proven UNSAT)\n";
+        else                                cout << "\t*** Certified Tc gap               : " << this->getBestTc() - this->getProvenUnsatTc()
+                                                 << " (proven UNSAT at Tc = " << this->getProvenUnsatTc() << ")\n";
+    }
     if(this->ifPlaceDcc())
     {
         cout << "\t*** # of minisat executions        : " << this->getMinisatExecuteNumber() << "\n";
+        if( !this->ifExternalSat() )
+            cout << "\t*** # of SAT conflicts             : " << this->getSatConflictNumber() << "\n";
+        if( this->getPortfolioNumber() > 1 )
+        {
+            cout << "\t*** Portfolio wins                 : " ;
+            for( int conf = 0; conf < this->getPortfolioNumber(); conf++ )
+                cout << this->getPortfolioName(conf) << "(" << this->getPortfolioWinNumber(conf) << ") " ;
+            cout << "\n";
+        }
         cout << "\t*** # of DCC condidates            : " << this->getTotalBufferNumber() - this->getNonPlacedDccBufferNumber() << "\n";
     }
     this->printDccList();
     this->printBufferInsertedList();
     this->printVTAList();
     this->printClauseCount();
+    this->printUnsatCore();
+}
+
+/*------------------------------------------------------------------------------------
+ FuncName:
+    printUnsatCore
+ Introduction:
+    Print the critical paths of the UNSAT core ("-unsat_core"), with the highest
+    critical Tc of their timing clauses and the clock nodes those clauses refer to
+ -------------------------------------------------------------------------------------*/
+void ClockTree::printUnsatCore()
+{
+    if( !this->ifUnsatCore() ) return ;
+    if( this->getUnsatCoreTc() < 0 )
+    {
+        cout << "\t*** UNSAT core                     : N/A (no Tc proven UNSAT)\n";
+        return ;
+    }
+    cout << "\t*** UNSAT core                     : " << this->_unsatcore.size() << " critical paths can't meet Tc = " << this->getUnsatCoreTc() << "\n";
+    set< long >           corepath( this->_unsatcore.begin(), this->_unsatcore.end() );
+    map< long, double >   pathtcth ;
+    map< long, set<long> > pathnode ;
+    map< int, long >      latencydef ;//latency var -> its definition (nodes of the configuration)
+    for( long idx = 0; idx < this->_latencydeflist.size(); idx++ )
+        latencydef[ this->_latencydeflist.getLiterals(idx)[ this->_latencydeflist.getClauseSize(idx) - 1 ] ] = idx ;
+    long prefix = this->getTimingClausePrefix( this->getUnsatCoreTc() );
+    for( long loop = 0; loop < prefix; loop++ )
+    {
+        TIMING_CLAUSE &entry = this->_tcclausedb[loop] ;
+        if( corepath.count( entry._pathnum ) == 0 ) continue ;
+        pathtcth[entry._pathnum] = max( pathtcth[entry._pathnum], entry._tcth );
+        for( auto const& lit: this->_tcclausearena.getClause( entry._clause ) )
+        {
+            vector< int > nodelits( 1, lit );
+            map< int, long >::iterator found = latencydef.find( abs( lit ) );
+            if( found != latencydef.end() )
+                nodelits.assign( this->_latencydeflist.getLiterals( found->second ), this->_latencydeflist.getLiterals( found->second ) + this->_latencydeflist.getClauseSize( found->second ) - 1 );
+            for( auto nodelit: nodelits )
+            {
+                CTN *node = this->getVarNode( abs( nodelit ) );
+                if( node != nullptr ) pathnode[entry._pathnum].insert( node->getNodeNumber() );
+            }
+        }
+    }
+    for( auto const& path: this->_pathlist )
+    {
+        if( corepath.count( path->getPathNum() ) == 0 ) continue ;
+        cout << "\t    Path(" << path->getPathNum() << ") " ;
+        path->coutPathType();
+        cout << ", " << path->getStartPointName() << " -> " << path->getEndPointName() ;
+        cout << ", critical Tc = " << pathtcth[path->getPathNum()] << ", clock nodes:" ;
+        for( auto const& node: pathnode[path->getPathNum()] ) cout << " " << node ;
+        cout << "\n";
+    }
 }
 
 bool compare( CP* A, CP*B )
@@ -759,11 +920,7 @@ bool compare( CP* A, CP*B )
 
 void ClockTree::SortCPbySlack( bool DCCHTV, bool update )
 {
-    for( auto const& path: this->_pathlist )
-    {
-        if( (path->getPathType() != PItoFF) && (path->getPathType() != FFtoPO) && (path->getPathType() != FFtoFF) ) continue;
-        UpdatePathTiming( path, update, DCCHTV, true );
-    }
+    sweepPathTiming( update, DCCHTV, true );
     sort( this->getPathList().begin(), this->getPathList().end(), compare );
     
 }
@@ -977,21 +1134,18 @@ void ClockTree::RemoveDCCandSeeResult2( CTN*node, int mode )
 		node->setIfPlaceHeader(0).setVTAType(-1) ;
 		printf("If %4ld(H, Depth = %ld) is removed:\n", node->getNodeNumber(), node->getDepth()  );
 	}
-		
-	for( long p = 0; p < getPathList().size(); p++ )
+	//---- Only the paths passing through the node are re-timed --
+	this->retimeClockNode( node );
+	for( long p: this->getViolatingPathList() )
 	{
 		pptr = getPathList().at(p);
-		if( pptr->getPathType() == NONE ) continue;
-			
-		if( UpdatePathTiming( pptr, false, true, true ) < 0 )
-		{
-			getNodeSide( Side, node, pptr );
-			if( mode ) printf("\t%4ld(%s" RST") in failing path ", node->getNodeNumber(), Side.c_str() );
-			FindDCCLeaderInPathVector( pptr );
-		}
+		getNodeSide( Side, node, pptr );
+		if( mode ) printf("\t%4ld(%s" RST") in failing path ", node->getNodeNumber(), Side.c_str() );
+		FindDCCLeaderInPathVector( pptr );
 	}//for-path
 	if( mode == 1 ){ node->setIfPlaceDcc(1).setDccType(init_DCCType)   ; }
 	if( mode == 2 ){ node->setIfPlaceHeader(1).setVTAType(init_LibType); }
+	this->retimeClockNode( node );
 }
 void ClockTree::RemoveDCCandSeeResult( vector<CTN*> &vDeploy, int mode )
 {
@@ -1000,6 +1154,7 @@ void ClockTree::RemoveDCCandSeeResult( vector<CTN*> &vDeploy, int mode )
     //---- Declaration --------------------------------------
 	CTN* node = NULL;
 	long ctrl = 0   ;
+	this->initIncrementalTiming( false, true, true );
 	//---- Mode ---------------------------------------------
 	while( true )
 	{
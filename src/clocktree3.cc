@@ -150,10 +150,12 @@ bool ClockTree::PathIsPlacedDCCorLeader( CP *pptr, int mode )
 void ClockTree::minimizeBufferInsertion2()
 {
 	if( this->_bufinsert < 1 || this->_bufinsert > 3 ) return;
+	this->_clklatenready = false ;//clock latency table is stale
 	
 	printf("The threshold of ratio while lifting buffers\nYour thred = ");
 	double thred = 0;
 	cin >> thred;
+	this->initIncrementalTiming( 1, 0, 1, 1 );
 	this->minimizeBufferInsertion2( this->_clktreeroot, thred );
 	this->calBufInserOrClockGating(0);
 	
@@ -208,17 +210,9 @@ void ClockTree::minimizeBufferInsertion2( CTN* node, double thred )
 		node->setIfInsertBuffer(1);
 		node->setInsertBufferDelay(max_buf_delay);
 		
-		//--- Check Timing after buffer lifting -------------
-		bool timing_vio = 0;
-		for( auto const &path: this->_pathlist )
-		{
-			if( path->getPathType() == NONE || path->getPathType() == PItoPO ) continue;
-			double slack = this->UpdatePathTiming( path, 1, 0, 1, 1 );
-			if( slack < 0 ){
-				timing_vio = 1;
-				break;
-			}
-		}
+		//--- Check Timing after buffer lifting (paths passing through the node) --
+		this->retimeClockNode( node );
+		bool timing_vio = ( this->getFirstViolatingPath() != nullptr );
 		
 		if( timing_vio )
 		{
@@ -228,6 +222,7 @@ void ClockTree::minimizeBufferInsertion2( CTN* node, double thred )
 					child->setIfInsertBuffer(1);//recover its status
 			node->setIfInsertBuffer(0);
 			node->setInsertBufferDelay(0);
+			this->retimeClockNode( node );
 			printf( RED"\t[Failing in lifting]\n" RST );
 		}else{
 			//while succeed in buffer lifting, clean the children's inserted buffer
@@ -275,6 +270,7 @@ void ClockTree::clockgating()
 	this->SortCPbySlack( 0 /*Do not consider DCC*/, 0);
 	
 	if( this->_program_ctl != 10 ) return;
+	this->_clklatenready = false ;//clock latency table is stale
 	for( auto pptr: this->_pathlist )
 	{
 		if( pptr->getPathType() == NONE || pptr->getPathType() == PItoPO ) continue;
@@ -312,6 +308,8 @@ void ClockTree::clockgating()
     printf("Your merging threshold:");
     
 	cin >> thd ;
+	this->_tc = this->_tcAfterAdjust;
+	this->initIncrementalTiming( 0, 0, 1, 0 );
 	this->GatedCellRecursive( this->_clktreeroot, thd );
 	
 	FILE *fPtr;
@@ -363,21 +361,19 @@ void ClockTree::GatedCellRecursive( CTN* node, double thred )
 		node->setIfClockGating(1);
 		node->setGatingProbability( min_prob );
 		
-		//After trying insert gated cell, checking timing
+		//After trying insert gated cell, checking timing (paths passing through the node)
 		this->_tc = this->_tcAfterAdjust;
-		for( auto const & path: this->_pathlist )
+		this->retimeClockNode( node );
+		if( this->getFirstViolatingPath( false ) != nullptr )
 		{
-			if( path->getPathType() == NONE || path->getPathType() == PItoPO || path->getPathType() == FFtoPO ) continue;
-			if( UpdatePathTiming( path, 0, 0, 1, 0 ) < 0 )
-			{
-				printf("Cannot merged to node(%ld) due to timing error\n", node->getNodeNumber() );
-				node->setIfClockGating(0);
-				node->setGatingProbability(0);
-				//recover
-				for( auto const &child: node->getChildren() )
-					if( child->getGatingProbability() != 0 )
-						child->setIfClockGating(1);
-			}
+			printf("Cannot merged to node(%ld) due to timing error\n", node->getNodeNumber() );
+			node->setIfClockGating(0);
+			node->setGatingProbability(0);
+			//recover
+			for( auto const &child: node->getChildren() )
+				if( child->getGatingProbability() != 0 )
+					child->setIfClockGating(1);
+			this->retimeClockNode( node );
 		}
 	}//thred
 }
@@ -515,22 +511,8 @@ double ClockTree::PV_Tc_estimation()
 {
 	this->_tc = this->_besttc;//from "./setting/DccVTA.txt
 	double Tc_PV = this->_tc;
-	double Min_slack = 999 ;
-	double slk		 = 0   ;
 	CP*    CP_minslk = NULL;
-	
-	for( auto const &path: this->_pathlist )
-	{
-		if( path->getPathType() == NONE || path->getPathType() == PItoPO ) continue;
-		slk = UpdatePathTiming( path, 1, 1, 1, 1, 1 );
-		
-		if( slk < Min_slack )
-		{
-			Min_slack = slk ;
-			CP_minslk = path;
-		}
-		
-	}
+	double Min_slack = sweepPathTiming( 1, 1, 1, 1, &CP_minslk );
 	if( Min_slack < 0 )
 		Tc_PV -= Min_slack - 0.0000001;
 	else//Min_slack > 0
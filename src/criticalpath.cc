@@ -274,15 +274,10 @@ ClockTreeNode *CriticalPath::findLastSameParentNode(void)
 ClockTreeNode *CriticalPath::findDccInClockPath(char who)
 {
 	ClockTreeNode *findnode = nullptr;
-	vector<ClockTreeNode *> clkpath;
-	// startpoint
-	if(who == 's')
-		clkpath = this->_startpclkpath;
-	// endpoint
-	else if(who == 'e')
-		clkpath = this->_endpclkpath;
-	else
+	if(who != 's' && who != 'e')
 		return nullptr;
+	// startpoint or endpoint (no copy, called for every path timing)
+	const vector<ClockTreeNode *> &clkpath = (who == 's') ? this->_startpclkpath : this->_endpclkpath;
 	for(auto const &nodeptr : clkpath)
 	{
 		if( nodeptr->ifPlacedDcc() )
@@ -302,15 +297,10 @@ ClockTreeNode *CriticalPath::findDccInClockPath(char who)
 ClockTreeNode *CriticalPath::findVTAInClockPath(char who)
 {
     ClockTreeNode *findnode = nullptr;
-    vector<ClockTreeNode *> clkpath;
-    // startpoint
-    if(who == 's')
-        clkpath = this->_startpclkpath;
-    // endpoint
-    else if(who == 'e')
-        clkpath = this->_endpclkpath;
-    else
+    if(who != 's' && who != 'e')
         return nullptr;
+    // startpoint or endpoint (no copy, called for every path timing)
+    const vector<ClockTreeNode *> &clkpath = (who == 's') ? this->_startpclkpath : this->_endpclkpath;
     for(auto const &nodeptr : clkpath)
     {
         if( nodeptr->getVTAType() != -1 )
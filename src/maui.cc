@@ -44,14 +44,25 @@ int main(int argc, char **argv)
             cout << "      -dump=SAT_CNF          Decode other CNF files and dump its DCC/Leader Deployment/Selection\n";
             cout << "      -print=path            Print the pipeline\n";
             cout << "      -print=Clause          Dump clauses while execution\n";
+            cout << "      -sat=minisat           Solve CNF by fork/exec of ./minisat instead of the built-in SAT engine\n";
+            cout << "      -tc_search=discrete    Bisect over the critical Tc of timing clauses (exact optimal Tc)\n";
+            cout << "      -portfolio [num]       Race [num] solver configurations per SAT call, first answer wins. [num] = 1~4. (default [num] = 1)\n";
+            cout << "      -sat_conflicts [num]   Conflict budget of each SAT call; out of budget is UNKNOWN (built-in engine). (default no limit)\n";
+            cout << "      -sat_timeout [sec]     Wall-clock budget of each SAT call; out of budget is UNKNOWN. (default no limit)\n";
+            cout << "      -phase_hint=off        Don't warm start a SAT call with the phases of the latest SAT model (built-in engine)\n";
+            cout << "      -unsat_core            Report the critical paths (UNSAT core) that pin the optimal Tc\n";
+            cout << "      -jobs [num]            Search Tc by [num] concurrent SAT probes per round (k-section). (default [num] = 1)\n";
+            cout << "      -components [num]      Search Tc of the independent components of the CNF by [num] threads, then take the largest\n";
+            cout << "      -threads [num]         Generate timing clauses and time the critical paths by [num] threads. (default [num] = 1)\n";
+            cout << "      -lazy [num]            Generate timing clauses of the [num] most critical paths first, then of the paths the SAT models violate\n";
+            cout << "      -sta_check             Cross-check every incremental re-timing (DCC/leader/buffer minimization) with full recomputation\n";
             cout << "      -print=CP              print associated DCC/Leader deployment of top 10 CP\n";
             cout << "      -dc_for                formulat the situation that dcc impacted by leader\n";
             cout << "      -checkCNF              Check the DCC/Leader deployment/Selection, based on given CNF output file\n";
             cout << "      -checkFile             Check the DCC/Leader deployment/Selection, based on given DccVTA.txt \n";
             cout << "      -calVTA                Calculate HTV Buffer # of associated Leader, based on given DccVTA.txt \n";
             cout << "      -aging=Senior           \n";
-			cout << "      -mindcc                Minimize the number of DCCs placed in clock tree. (default disable)\n";
-			cout << "                               Enable when \'-nondcc\' option enable.\n";
+			cout << "      -mindcc                Minimize the number of DCCs, then leaders, at the optimal Tc by SAT. (default disable)\n";
 			cout << "      -tc_recheck            Check Tc again after binary search. (default disable)\n";
 			cout << "      -mask_leng [ratio]     Set the length of mask on clock path. [ratio] = 0~1. (default [ratio] = 0.5)\n";
 			cout << "      -mask_level [num]      Mask number of clock tree level from bottom. [num] >= 0. (default [num] = 0)\n";
@@ -94,7 +105,7 @@ int main(int argc, char **argv)
 	
 	// Parameters storing execution time of each part of framework
 	chrono::steady_clock::time_point starttime, endtime, midtime;
-	chrono::duration<double> totaltime, preprocesstime, DccVTAconstrainttime, timingconstrainttime1, timingconstrainttime2, sattime, sattime2, minitime, bufinstime;
+	chrono::duration<double> totaltime{}, preprocesstime{}, DccVTAconstrainttime{}, timingconstrainttime1{}, timingconstrainttime2{}, sattime{}, sattime2{}, minitime{}, bufinstime{};
 	
     printf( YELLOW"[Parser]" RST" Reading timing report...\n" );
 	starttime = chrono::steady_clock::now();
@@ -141,6 +152,12 @@ int main(int argc, char **argv)
     DccVTAconstrainttime = chrono::duration_cast<chrono::duration<double>>(endtime - midtime);
 	//-------- Generate all kinds of DCC deployment ----------------------------------------
 	circuit.genDccPlacementCandidate();
+	//-------- Clock latency table: O(1) latency of clock paths ------------------------------
+	circuit.buildClockLatencyTable();
+	//-------- Timing edges: worst path of each pair of clock leaves ---------------------------
+	circuit.collapseTimingEdge();
+	//-------- Candidates of the discrete Tc search ------------------------------------------
+	circuit.initTcCandidate();
 	
     string Sat = "";
     int    itr_ctr = 1 ;
@@ -155,39 +172,107 @@ int main(int argc, char **argv)
 	printf( YELLOW"[Binary Search for Tc]" RST" Analyzing Timing Constraint and Searching Optimal Tc...\033[0m\n" );
 	double pretc = 0, prepretc = 0;
     long   clause_ctr = 0 ;
-	while( 1 )
-	{
-        Tc = circuit.getTc();
-        printf( RST"\n\t" YELLOW"[" CYAN"%3d" YELLOW" th of Binary Search for Tc]\n", itr_ctr );
-        printf( YELLOW"\t[--Clock Period---] " RST"Tc = %f \n", Tc );
-        
-		midtime = chrono::steady_clock::now();
-		//---- Timing constraint method (Clauses)--------------------------------------------
-		clause_ctr = circuit.timingConstraint();
-		//---- Generate CNF file ------------------------------------------------------------
-		circuit.dumpClauseToCnfFile();
-		endtime = chrono::steady_clock::now();
-        //---- Constraint Time --------------------------------------------------------------
-        timingconstrainttime1 = chrono::duration_cast<chrono::duration<double>>(endtime - midtime);
-        timingconstrainttime2 += timingconstrainttime1;
-		printf( YELLOW"\t[--Clause (time)--] " RST"runtime: %f (only CNF generation)\n", timingconstrainttime1.count());
-        prepretc = pretc; pretc = circuit.getTc();
-		//---- MiniSat ----------------------------------------------------------------------
+    //-------- Parallel k-section search ("-jobs N") -----------------------------------------
+    if( circuit.getJobNumber() > 1 )
+    {
+        while( 1 )
+        {
+            Tc_L = circuit.getTcLowerBound(); Tc_U = circuit.getTcUpperBound();
+            printf( RST"\n\t" YELLOW"[" CYAN"%3d" YELLOW" th round of k-Section Search for Tc]\n", itr_ctr );
+            printf( YELLOW"\t[--Clock Period---] " RST"Tc range = %f - %f \n", Tc_L, Tc_U );
+            double dbtime = circuit.getTimingClauseDBTime();
+            midtime = chrono::steady_clock::now();
+            circuit.execMinisatParallel();
+            endtime = chrono::steady_clock::now();
+            //---- Constraint Time (shared timing clause DB) --------------------------------
+            timingconstrainttime1 = chrono::duration<double>(circuit.getTimingClauseDBTime() - dbtime);
+            timingconstrainttime2 += timingconstrainttime1;
+            sattime2 = chrono::duration_cast<chrono::duration<double>>(endtime - midtime) - timingconstrainttime1;
+            sattime += sattime2;
+            if( timingconstrainttime1.count() > 0 )
+                printf( YELLOW"\t[--Clause (time)--] " RST"runtime: %f (timing clause DB)\n", timingconstrainttime1.count());
+            printf( YELLOW"\t[-MiniSAT (time)--] " RST"runtime: %f (%ld probes in parallel)\n", sattime2.count(), circuit.getTcProbeList().size() );
+            //---- Per-probe log ------------------------------------------------------------
+            for( auto const& probe: circuit.getTcProbeList() )
+            {
+                Sat = ( probe._status == SAT_SAT )?("SAT"):( ( probe._status == SAT_UNSAT )?("UNSAT"):( ( probe._cancelled )?("CANCELLED"):("UNKNOWN") ) );
+                printf( YELLOW"\t[--Probe----------] " RST"Tc = %f, Cl# = %ld, runtime: %f, %s\n", probe._tc, probe._clausenum, probe._time, Sat.c_str() );
+                fprintf( fPtr, "%d. Cl#=%ld, Tc_U=%f, Tc_L=%f,T_m=%.9f, T_solver=%f, %s\n", itr_ctr, probe._clausenum, Tc_U, Tc_L, probe._tc, probe._time, Sat.c_str() );
+            }
+            itr_ctr++ ;
+            if( circuit.tcKSectionSearch() ) break;
+        }
+    }
+    //-------- Independent components searched in parallel ("-components N") -----------------
+    else if( circuit.getComponentJobNumber() > 0 && ( circuit.ifPlaceDcc() || circuit.ifdoVTA() ) )
+    {
+        printf( RST"\n\t" YELLOW"[Component Search for Tc]\n" );
+        double dbtime = circuit.getTimingClauseDBTime();
         midtime = chrono::steady_clock::now();
-		circuit.execMinisat();
+        circuit.execMinisatByComponent();
         endtime = chrono::steady_clock::now();
-        sattime2 = chrono::duration_cast<chrono::duration<double>>(endtime - midtime);
-        sattime += sattime2;
-        printf( YELLOW"\t[-MiniSAT (time)--] " RST"runtime: %f (only MiniSAT)\n", sattime2.count());
-		//---- Set UB/LB Tc -----------------------------------------------------------------
-        Tc_L = circuit.getTcLowerBound(); Tc_U = circuit.getTcUpperBound();
-        Sat = ( circuit.tcBinarySearch())?("SAT"):("UNSAT");
-        fprintf( fPtr, "%d. Cl#=%ld, Tc_U=%f, Tc_L=%f,T_m=%f, T_tim_c=%f, T_solver=%f, %s\n", itr_ctr, clause_ctr, Tc_U, Tc_L, Tc, timingconstrainttime1.count(), sattime2.count(), Sat.c_str() );
+        //---- Constraint Time (timing clause DB and its components) ------------------------
+        timingconstrainttime1 = chrono::duration<double>(circuit.getTimingClauseDBTime() - dbtime);
+        timingconstrainttime2 += timingconstrainttime1;
+        sattime = chrono::duration_cast<chrono::duration<double>>(endtime - midtime) - timingconstrainttime1;
+        printf( YELLOW"\t[--Clause (time)--] " RST"runtime: %f (timing clause DB and components)\n", timingconstrainttime1.count());
+        printf( YELLOW"\t[-MiniSAT (time)--] " RST"runtime: %f (%lu components in parallel)\n", sattime.count(), circuit.getTcComponentList().size() );
+        //---- Per-component log --------------------------------------------------------------
+        long comp_ctr = 0 ;
+        for( auto const& comp: circuit.getTcComponentList() )
+        {
+            fprintf( fPtr, "%ld. Var#=%lu, Cl#=%lu, Tc_U=%f, Tc_L=%f, probes=%d, T_solver=%f, %s\n", comp_ctr++, comp._var.size(), comp._timing.size(),
+                     comp._upbound, comp._lowbound, comp._probenum, comp._time, ( comp._besttc != 0 ) ? "SAT" : "UNSAT" );
+        }
+    }
+    else
+    {
+		while( 1 )
+		{
+            Tc = circuit.getTc();
+            printf( RST"\n\t" YELLOW"[" CYAN"%3d" YELLOW" th of Binary Search for Tc]\n", itr_ctr );
+            printf( YELLOW"\t[--Clock Period---] " RST"Tc = %f \n", Tc );
         
-        itr_ctr++ ;
-		if( prepretc == circuit.getTc() ) break;
-	}
+			midtime = chrono::steady_clock::now();
+			//---- Timing constraint method (Clauses)--------------------------------------------
+			clause_ctr = circuit.timingConstraint();
+			//---- Generate CNF file ------------------------------------------------------------
+			circuit.dumpClauseToCnfFile();
+			endtime = chrono::steady_clock::now();
+            //---- Constraint Time --------------------------------------------------------------
+            timingconstrainttime1 = chrono::duration_cast<chrono::duration<double>>(endtime - midtime);
+            timingconstrainttime2 += timingconstrainttime1;
+			printf( YELLOW"\t[--Clause (time)--] " RST"runtime: %f (only CNF generation)\n", timingconstrainttime1.count());
+            prepretc = pretc; pretc = circuit.getTc();
+			//---- MiniSat ----------------------------------------------------------------------
+            midtime = chrono::steady_clock::now();
+			circuit.execMinisat();
+            endtime = chrono::steady_clock::now();
+            sattime2 = chrono::duration_cast<chrono::duration<double>>(endtime - midtime);
+            sattime += sattime2;
+            printf( YELLOW"\t[-MiniSAT (time)--] " RST"runtime: %f (only MiniSAT)\n", sattime2.count());
+			//---- Set UB/LB Tc -----------------------------------------------------------------
+            Tc_L = circuit.getTcLowerBound(); Tc_U = circuit.getTcUpperBound();
+            long th_idx = circuit.getTcCandidateIndex();
+            Sat = ( circuit.tcBinarySearch())?("SAT"):( ( circuit.getSatStatus() == SAT_UNKNOWN )?("UNKNOWN"):("UNSAT") );
+            if( circuit.getPortfolioNumber() > 1 ) Sat += " (" + circuit.getSatWinner() + ")";
+            if( circuit.ifTcDiscrete() && th_idx >= 0 )
+                fprintf( fPtr, "%d. Cl#=%ld, Tc_U=%f, Tc_L=%f,T_m=%.9f (th %ld/%ld), T_tim_c=%f, T_solver=%f, %s\n", itr_ctr, clause_ctr, Tc_U, Tc_L, Tc, th_idx, circuit.getTcCandidateNumber(), timingconstrainttime1.count(), sattime2.count(), Sat.c_str() );
+            else
+                fprintf( fPtr, "%d. Cl#=%ld, Tc_U=%f, Tc_L=%f,T_m=%f, T_tim_c=%f, T_solver=%f, %s\n", itr_ctr, clause_ctr, Tc_U, Tc_L, Tc, timingconstrainttime1.count(), sattime2.count(), Sat.c_str() );
+        
+            itr_ctr++ ;
+			if( prepretc == circuit.getTc() || circuit.ifTcSearchDone() ) break;
+		}
+    }
 	
+    //-------- Anytime result: a proven Tc even if every probe is out of budget ------------------
+    circuit.tcAnytimeFallback();
+    //-------- Critical paths pinning the optimal Tc ("-unsat_core") -------------------------
+    circuit.extractUnsatCore();
+    //-------- Minimum DCC/leader deployment at the optimal Tc ("-mindcc") ---------------------
+    circuit.minimizeDccLeaderBySat();
+    
     //4. Update the timing of each critical path with given "Optimal tc"
     printf( YELLOW"[Update]" RST"Update path timing (formally DCC deployment and leader selection)\n" );
 	circuit.updateAllPathTiming();
@@ -0,0 +1,751 @@
+//////////////////////////////////////////////////////////////
+//
+// Source File
+//
+// File name: satsolver.cc
+// Introduction:
+//    In-process incremental CDCL SAT solver used by the binary
+//    search of Tc instead of fork/exec of ./minisat.
+//
+//////////////////////////////////////////////////////////////
+
+#include "satsolver.h"
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <algorithm>
+
+/////////////////////////////////////////////////////////////////////
+//
+// SatSolver Class - Constructor/Destructor
+//
+/////////////////////////////////////////////////////////////////////
+SatSolver::SatSolver( void )
+         : _ok(true), _qhead(0), _simpassigns(0), _varinc(1), _vardecay(0.95), _clainc(1), _cladecay(0.999), _maxlearnts(0),
+           _solves(0), _conflicts(0), _decisions(0), _propagations(0), _interrupt(false), _randseed(0),
+           _conflictbudget(-1), _timebudget(0), _solveconflicts(0)
+{
+    this->_config = SAT_CONFIG{ SAT_RESTART_LUBY, 100, 2, 0, 0, SAT_PHASE_NEG };
+}
+
+SatSolver::~SatSolver( void )
+{
+    for( auto c: this->_clauses ) delete c ;
+    for( auto c: this->_learnts ) delete c ;
+    this->_clauses.clear();
+    this->_learnts.clear();
+}
+
+/*------------------------------------------------------------------------------------
+ FuncName:
+    setConfig
+ Introduction:
+    Select the restart/phase/random-seed configuration (portfolio member)
+    Call it before creating any variable
+ -------------------------------------------------------------------------------------*/
+void SatSolver::setConfig( const SAT_CONFIG &config )
+{
+    this->_config   = config ;
+    this->_randseed = config._seed ;
+}
+
+/*------------------------------------------------------------------------------------
+ FuncName:
+    newVar, reserveVars
+ Introduction:
+    Create a new variable and return its DIMACS index (1, 2, ...)
+    reserveVars makes sure variable 1 ~ nvars exist
+ -------------------------------------------------------------------------------------*/
+int SatSolver::newVar( void )
+{
+    int var = (int)this->_assigns.size();
+    this->_assigns.push_back(0);
+    if( this->_config._phase == SAT_PHASE_RAND )    this->_polarity.push_back( ( this->drand() < 0.5 ) ? 1 : 0 );
+    else                                            this->_polarity.push_back( ( this->_config._phase == SAT_PHASE_POS ) ? 0 : 1 );
+    this->_reason.push_back(nullptr);
+    this->_level.push_back(0);
+    this->_activity.push_back( ( this->_randseed > 0 ) ? this->drand() * 0.00001 : 0 );
+    this->_seen.push_back(0);
+    this->_heapidx.push_back(-1);
+    this->_watches.resize( 2*(var+1) );
+    this->heapInsert(var);
+    return var+1 ;
+}
+
+void SatSolver::reserveVars( int nvars )
+{
+    while( this->nVars() < nvars ) this->newVar();
+}
+
+/*------------------------------------------------------------------------------------
+ FuncName:
+    setPhase
+ Introduction:
+    Warm start: overwrite the saved phase of each var with its polarity in
+    "model" (e.g. a model of a previous call), so the next decisions follow it.
+    Literals of vars that do not exist yet are ignored. Phase saving replaces
+    the hints as soon as the search backtracks over them.
+ -------------------------------------------------------------------------------------*/
+void SatSolver::setPhase( const vector<int> &model )
+{
+    for( auto dimacs: model )
+    {
+        int var = abs(dimacs) - 1 ;
+        if( dimacs == 0 || var >= this->nVars() ) continue ;
+        this->_polarity[var] = ( dimacs < 0 ) ? 1 : 0 ;
+    }
+}
+
+/*------------------------------------------------------------------------------------
+ FuncName:
+    addClause
+ Introduction:
+    Add a clause at decision level 0. Satisfied clauses and false
+    literals are dropped. Return false if the solver becomes UNSAT.
+ -------------------------------------------------------------------------------------*/
+bool SatSolver::addClause( const vector<int> &lits )
+{
+    return this->addClause( lits.data(), (long)lits.size() );
+}
+
+bool SatSolver::addClause( const int *lits, long size )
+{
+    if( !this->_ok ) return false ;
+    this->cancelUntil(0);
+
+    vector<int> ps ;
+    ps.reserve( size );
+    for( long loop = 0; loop < size; loop++ )
+    {
+        int dimacs = lits[loop] ;
+        if( dimacs == 0 ) continue ;
+        this->reserveVars( abs(dimacs) );
+        ps.push_back( toLit(dimacs) );
+    }
+    sort( ps.begin(), ps.end() );
+
+    //-- Remove duplicated/false literals, skip satisfied/tautology clause ----------
+    int j = 0, prev = -1 ;
+    for( int i = 0; i < (int)ps.size(); i++ )
+    {
+        int p = ps[i] ;
+        if( this->value(p) == 1 || p == (prev ^ 1) ) return true ;
+        else if( this->value(p) != -1 && p != prev )
+            ps[j++] = prev = p ;
+    }
+    ps.resize(j);
+
+    if( ps.empty() )
+        return this->_ok = false ;
+    else if( ps.size() == 1 )
+    {
+        this->enqueue( ps[0], nullptr );
+        return this->_ok = ( this->propagate() == nullptr );
+    }
+    Clause *c = new Clause ;
+    c->learnt = false ; c->removed = false ; c->act = 0 ; c->lits.swap(ps);
+    this->_clauses.push_back(c);
+    this->attachClause(c);
+    return true ;
+}
+
+bool SatSolver::addClause( const string &clause )
+{
+    vector<int> lits ;
+    const char *ptr = clause.c_str();
+    char *end = nullptr ;
+    while( true )
+    {
+        long lit = strtol( ptr, &end, 10 );
+        if( end == ptr ) break ;
+        if( lit != 0 ) lits.push_back( (int)lit );
+        ptr = end ;
+    }
+    return this->addClause( lits );
+}
+
+/////////////////////////////////////////////////////////////////////
+//
+// SatSolver Class - Private Method
+// VSIDS heap (max-heap on variable activity)
+//
+/////////////////////////////////////////////////////////////////////
+void SatSolver::heapUp( int pos )
+{
+    int var = this->_heap[pos] ;
+    while( pos > 0 )
+    {
+        int parent = (pos - 1) >> 1 ;
+        if( !this->heapLess( var, this->_heap[parent] ) ) break ;
+        this->_heap[pos] = this->_heap[parent] ;
+        this->_heapidx[this->_heap[pos]] = pos ;
+        pos = parent ;
+    }
+    this->_heap[pos] = var ;
+    this->_heapidx[var] = pos ;
+}
+
+void SatSolver::heapDown( int pos )
+{
+    int var = this->_heap[pos], size = (int)this->_heap.size() ;
+    while( 2*pos + 1 < size )
+    {
+        int child = 2*pos + 1 ;
+        if( child + 1 < size && this->heapLess( this->_heap[child+1], this->_heap[child] ) ) child++ ;
+        if( !this->heapLess( this->_heap[child], var ) ) break ;
+        this->_heap[pos] = this->_heap[child] ;
+        this->_heapidx[this->_heap[pos]] = pos ;
+        pos = child ;
+    }
+    this->_heap[pos] = var ;
+    this->_heapidx[var] = pos ;
+}
+
+void SatSolver::heapInsert( int var )
+{
+    if( this->_heapidx[var] >= 0 ) return ;
+    this->_heap.push_back(var);
+    this->_heapidx[var] = (int)this->_heap.size() - 1 ;
+    this->heapUp( this->_heapidx[var] );
+}
+
+int SatSolver::heapPop( void )
+{
+    int var = this->_heap[0] ;
+    this->_heap[0] = this->_heap.back() ;
+    this->_heapidx[this->_heap[0]] = 0 ;
+    this->_heapidx[var] = -1 ;
+    this->_heap.pop_back();
+    if( this->_heap.size() > 1 ) this->heapDown(0);
+    return var ;
+}
+
+void SatSolver::varBump( int var )
+{
+    if( ( this->_activity[var] += this->_varinc ) > 1e100 )
+    {
+        for( auto &act: this->_activity ) act *= 1e-100 ;
+        this->_varinc *= 1e-100 ;
+    }
+    if( this->_heapidx[var] >= 0 ) this->heapUp( this->_heapidx[var] );
+}
+
+void SatSolver::claBump( Clause *c )
+{
+    if( ( c->act += this->_clainc ) > 1e20 )
+    {
+        for( auto l: this->_learnts ) l->act *= 1e-20 ;
+        this->_clainc *= 1e-20 ;
+    }
+}
+
+/////////////////////////////////////////////////////////////////////
+//
+// SatSolver Class - Private Method
+// Assignment, propagation and backtracking
+//
+/////////////////////////////////////////////////////////////////////
+void SatSolver::attachClause( Clause *c )
+{
+    this->_watches[c->lits[0] ^ 1].push_back( Watcher( c, c->lits[1] ) );
+    this->_watches[c->lits[1] ^ 1].push_back( Watcher( c, c->lits[0] ) );
+}
+
+//Drop the watchers of removed clauses
+void SatSolver::detachAll( void )
+{
+    for( auto &ws: this->_watches )
+    {
+        long j = 0 ;
+        for( long i = 0; i < (long)ws.size(); i++ )
+            if( !ws[i].cref->removed ) ws[j++] = ws[i] ;
+        ws.resize(j);
+    }
+}
+
+void SatSolver::enqueue( int lit, Clause *from )
+{
+    int var = lit >> 1 ;
+    this->_assigns[var] = ( lit & 1 ) ? -1 : 1 ;
+    this->_level[var]   = this->decisionLevel() ;
+    this->_reason[var]  = from ;
+    this->_trail.push_back(lit);
+}
+
+SatSolver::Clause* SatSolver::propagate( void )
+{
+    Clause *confl = nullptr ;
+    while( this->_qhead < (long)this->_trail.size() )
+    {
+        int p = this->_trail[this->_qhead++] ;
+        int falselit = p ^ 1 ;
+        vector<Watcher> &ws = this->_watches[p] ;
+        long i = 0, j = 0, size = (long)ws.size() ;
+        this->_propagations++ ;
+
+        while( i < size )
+        {
+            //-- Blocker is true, skip the clause ---------------------------------------
+            if( this->value( ws[i].blocker ) == 1 ) { ws[j++] = ws[i++]; continue; }
+
+            Clause *c = ws[i].cref ;
+            vector<int> &lits = c->lits ;
+            if( lits[0] == falselit ) { lits[0] = lits[1]; lits[1] = falselit; }
+            i++ ;
+
+            int first = lits[0] ;
+            Watcher w( c, first );
+            if( first != ws[i-1].blocker && this->value(first) == 1 ) { ws[j++] = w; continue; }
+
+            //-- Look for a new watch ---------------------------------------------------
+            bool found = false ;
+            for( long k = 2; k < (long)lits.size(); k++ )
+            {
+                if( this->value( lits[k] ) != -1 )
+                {
+                    lits[1] = lits[k]; lits[k] = falselit ;
+                    this->_watches[lits[1] ^ 1].push_back(w);
+                    found = true ;
+                    break ;
+                }
+            }
+            if( found ) continue ;
+
+            //-- Clause is unit or conflicting ------------------------------------------
+            ws[j++] = w ;
+            if( this->value(first) == -1 )
+            {
+                confl = c ;
+                this->_qhead = (long)this->_trail.size() ;
+                while( i < size ) ws[j++] = ws[i++] ;
+            }
+            else
+                this->enqueue( first, c );
+        }
+        ws.resize(j);
+        if( confl != nullptr ) break ;
+    }
+    return confl ;
+}
+
+void SatSolver::cancelUntil( int level )
+{
+    if( this->decisionLevel() <= level ) return ;
+    for( long c = (long)this->_trail.size() - 1; c >= this->_traillim[level]; c-- )
+    {
+        int var = this->_trail[c] >> 1 ;
+        this->_assigns[var]  = 0 ;
+        this->_reason[var]   = nullptr ;
+        this->_polarity[var] = this->_trail[c] & 1 ;
+        this->heapInsert(var);
+    }
+    this->_qhead = this->_traillim[level] ;
+    this->_trail.resize( this->_traillim[level] );
+    this->_traillim.resize(level);
+}
+
+int SatSolver::pickBranchLit( void )
+{
+    int next = -1 ;
+    //-- Random decision -------------------------------------------------------------------
+    if( this->_randseed > 0 && !this->_heap.empty() && this->drand() < this->_config._randfreq )
+    {
+        next = this->_heap[ (int)( this->drand() * this->_heap.size() ) ] ;
+        if( this->_assigns[next] != 0 ) next = -1 ;
+    }
+    while( next == -1 || this->_assigns[next] != 0 )
+    {
+        if( this->_heap.empty() ) return -1 ;
+        next = this->heapPop();
+    }
+    return 2*next + this->_polarity[next] ;
+}
+
+/////////////////////////////////////////////////////////////////////
+//
+// SatSolver Class - Private Method
+// Conflict analysis (first UIP + recursive minimization)
+//
+/////////////////////////////////////////////////////////////////////
+void SatSolver::analyze( Clause *confl, vector<int> &learnt, int &btlevel )
+{
+    int pathc = 0, p = -1 ;
+    long index = (long)this->_trail.size() - 1 ;
+    learnt.clear();
+    learnt.push_back(-1);
+
+    do{
+        if( confl->learnt ) this->claBump(confl);
+        vector<int> &lits = confl->lits ;
+        for( int j = ( p == -1 ) ? 0 : 1; j < (int)lits.size(); j++ )
+        {
+            int q = lits[j], var = q >> 1 ;
+            if( !this->_seen[var] && this->_level[var] > 0 )
+            {
+                this->varBump(var);
+                this->_seen[var] = 1 ;
+                if( this->_level[var] >= this->decisionLevel() ) pathc++ ;
+                else learnt.push_back(q);
+            }
+        }
+        while( !this->_seen[this->_trail[index--] >> 1] );
+        p = this->_trail[index+1] ;
+        confl = this->_reason[p >> 1] ;
+        this->_seen[p >> 1] = 0 ;
+        pathc-- ;
+    }while( pathc > 0 );
+    learnt[0] = p ^ 1 ;
+
+    //-- Minimize the learnt clause -------------------------------------------------
+    this->_toclear = learnt ;
+    unsigned abstractlevels = 0 ;
+    for( int i = 1; i < (int)learnt.size(); i++ )
+        abstractlevels |= 1u << ( this->_level[learnt[i] >> 1] & 31 );
+    int j = 1 ;
+    for( int i = 1; i < (int)learnt.size(); i++ )
+        if( this->_reason[learnt[i] >> 1] == nullptr || !this->litRedundant( learnt[i], abstractlevels ) )
+            learnt[j++] = learnt[i] ;
+    learnt.resize(j);
+
+    //-- Find backtrack level ---------------------------------------------------------
+    if( learnt.size() == 1 ) btlevel = 0 ;
+    else
+    {
+        int maxi = 1 ;
+        for( int i = 2; i < (int)learnt.size(); i++ )
+            if( this->_level[learnt[i] >> 1] > this->_level[learnt[maxi] >> 1] ) maxi = i ;
+        swap( learnt[1], learnt[maxi] );
+        btlevel = this->_level[learnt[1] >> 1] ;
+    }
+    for( auto lit: this->_toclear ) this->_seen[lit >> 1] = 0 ;
+}
+
+bool SatSolver::litRedundant( int lit, unsigned abstractlevels )
+{
+    this->_stack.clear();
+    this->_stack.push_back(lit);
+    long top = (long)this->_toclear.size() ;
+    while( !this->_stack.empty() )
+    {
+        vector<int> &lits = this->_reason[this->_stack.back() >> 1]->lits ;
+        this->_stack.pop_back();
+        for( int i = 1; i < (int)lits.size(); i++ )
+        {
+            int q = lits[i], var = q >> 1 ;
+            if( !this->_seen[var] && this->_level[var] > 0 )
+            {
+                if( this->_reason[var] != nullptr && ( ( 1u << ( this->_level[var] & 31 ) ) & abstractlevels ) != 0 )
+                {
+                    this->_seen[var] = 1 ;
+                    this->_stack.push_back(q);
+                    this->_toclear.push_back(q);
+                }
+                else
+                {
+                    for( long k = top; k < (long)this->_toclear.size(); k++ )
+                        this->_seen[this->_toclear[k] >> 1] = 0 ;
+                    this->_toclear.resize(top);
+                    return false ;
+                }
+            }
+        }
+    }
+    return true ;
+}
+
+/*------------------------------------------------------------------------------------
+ FuncName:
+    analyzeFinal
+ Introduction:
+    The assumption "lit" is false under the current assignment. Collect the
+    subset of assumptions implying it into _conflict (DIMACS literals).
+ -------------------------------------------------------------------------------------*/
+void SatSolver::analyzeFinal( int lit )
+{
+    this->_conflict.clear();
+    this->_conflict.push_back( toDimacs(lit) );
+    if( this->decisionLevel() == 0 ) return ;
+
+    this->_seen[lit >> 1] = 1 ;
+    for( long i = (long)this->_trail.size() - 1; i >= this->_traillim[0]; i-- )
+    {
+        int var = this->_trail[i] >> 1 ;
+        if( !this->_seen[var] ) continue ;
+        if( this->_reason[var] == nullptr )
+            this->_conflict.push_back( toDimacs( this->_trail[i] ) );
+        else
+        {
+            vector<int> &lits = this->_reason[var]->lits ;
+            for( int j = 1; j < (int)lits.size(); j++ )
+                if( this->_level[lits[j] >> 1] > 0 ) this->_seen[lits[j] >> 1] = 1 ;
+        }
+        this->_seen[var] = 0 ;
+    }
+    this->_seen[lit >> 1] = 0 ;
+}
+
+/////////////////////////////////////////////////////////////////////
+//
+// SatSolver Class - Private Method
+// Remove half of the learnt clauses with low activity
+//
+/////////////////////////////////////////////////////////////////////
+void SatSolver::reduceDB( void )
+{
+    double extralim = this->_clainc / max( (double)this->_learnts.size(), 1.0 );
+    sort( this->_learnts.begin(), this->_learnts.end(), []( Clause *x, Clause *y ){
+        return x->lits.size() > 2 && ( y->lits.size() == 2 || x->act < y->act ); } );
+
+    vector<Clause*> removed ;
+    long j = 0, half = (long)this->_learnts.size() / 2 ;
+    for( long i = 0; i < (long)this->_learnts.size(); i++ )
+    {
+        Clause *c = this->_learnts[i] ;
+        bool locked = ( this->_reason[c->lits[0] >> 1] == c ) && ( this->value( c->lits[0] ) == 1 );
+        if( c->lits.size() > 2 && !locked && ( i < half || c->act < extralim ) )
+        {
+            c->removed = true ;
+            removed.push_back(c);
+        }
+        else
+            this->_learnts[j++] = c ;
+    }
+    this->_learnts.resize(j);
+    this->detachAll();
+    for( auto c: removed ) delete c ;
+}
+
+/////////////////////////////////////////////////////////////////////
+//
+// SatSolver Class - Private Method
+// Delete the clauses satisfied at level 0 (e.g. the clauses of an
+// activation variable fixed to false), so they do not pile up
+//
+/////////////////////////////////////////////////////////////////////
+void SatSolver::simplify( void )
+{
+    if( this->decisionLevel() > 0 || (long)this->_trail.size() == this->_simpassigns ) return ;
+
+    vector<Clause*> removed ;
+    for( auto db: { &this->_clauses, &this->_learnts } )
+    {
+        long j = 0 ;
+        for( long i = 0; i < (long)db->size(); i++ )
+        {
+            Clause *c = (*db)[i] ;
+            bool sat = false ;
+            for( auto lit: c->lits )
+                if( this->value(lit) == 1 ) { sat = true; break; }
+            if( sat )
+            {
+                c->removed = true ;
+                removed.push_back(c);
+            }
+            else
+                (*db)[j++] = c ;
+        }
+        db->resize(j);
+    }
+    //-- Level-0 assignments need no reason; do not keep dangling ones --------------
+    for( auto lit: this->_trail ) this->_reason[lit >> 1] = nullptr ;
+    this->detachAll();
+    for( auto c: removed ) delete c ;
+    this->_simpassigns = (long)this->_trail.size() ;
+}
+
+/////////////////////////////////////////////////////////////////////
+//
+// SatSolver Class - Private Method
+// CDCL search until a model, UNSAT, or "nofconflicts" conflicts
+// (return -1 to restart, SAT_UNKNOWN if interrupted or out of budget)
+//
+/////////////////////////////////////////////////////////////////////
+int SatSolver::search( long nofconflicts )
+{
+    long conflictc = 0 ;
+    int  btlevel = 0 ;
+    vector<int> learnt ;
+
+    while( true )
+    {
+        Clause *confl = this->propagate();
+        if( confl != nullptr )
+        {
+            //-- Conflict ---------------------------------------------------------------
+            this->_conflicts++ ; conflictc++ ;
+            if( this->decisionLevel() == 0 )
+            {
+                this->_ok = false ;
+                return SAT_UNSAT ;
+            }
+            if( this->budgetOut() )
+            {
+                this->cancelUntil(0);
+                return SAT_UNKNOWN ;
+            }
+            this->analyze( confl, learnt, btlevel );
+            this->cancelUntil( btlevel );
+            if( learnt.size() == 1 )
+                this->enqueue( learnt[0], nullptr );
+            else
+            {
+                Clause *c = new Clause ;
+                c->learnt = true ; c->removed = false ; c->act = 0 ; c->lits = learnt ;
+                this->_learnts.push_back(c);
+                this->attachClause(c);
+                this->claBump(c);
+                this->enqueue( learnt[0], c );
+            }
+            this->_varinc *= ( 1 / this->_vardecay );
+            this->_clainc *= ( 1 / this->_cladecay );
+        }
+        else
+        {
+            //-- No conflict ------------------------------------------------------------
+            if( this->_interrupt )
+            {
+                this->cancelUntil(0);
+                return SAT_UNKNOWN ;
+            }
+            if( nofconflicts >= 0 && conflictc >= nofconflicts )
+            {
+                this->cancelUntil(0);
+                return -1 ;
+            }
+            if( (double)this->_learnts.size() - (double)this->_trail.size() >= this->_maxlearnts )
+                this->reduceDB();
+
+            int next = -1 ;
+            //-- Assumptions come first -------------------------------------------------
+            while( this->decisionLevel() < (int)this->_assumps.size() )
+            {
+                int p = this->_assumps[this->decisionLevel()] ;
+                if( this->value(p) == 1 )
+                    this->_traillim.push_back( (int)this->_trail.size() );//dummy level
+                else if( this->value(p) == -1 )
+                {
+                    this->analyzeFinal(p);
+                    return SAT_UNSAT ;
+                }
+                else
+                {
+                    next = p ;
+                    break ;
+                }
+            }
+            if( next == -1 )
+            {
+                this->_decisions++ ;
+                next = this->pickBranchLit();
+                if( next == -1 ) return SAT_SAT ;
+            }
+            this->_traillim.push_back( (int)this->_trail.size() );
+            this->enqueue( next, nullptr );
+        }
+    }
+}
+
+//-- Conflict/wall-clock budget of the current solve() (clock read every 64 conflicts) ------
+bool SatSolver::budgetOut( void )
+{
+    if( this->_conflictbudget >= 0 && this->_conflicts - this->_solveconflicts > this->_conflictbudget ) return true ;
+    if( this->_timebudget > 0 && ( this->_conflicts & 63 ) == 0 )
+        return chrono::duration_cast< chrono::duration<double> >( chrono::steady_clock::now() - this->_solvestart ).count() > this->_timebudget ;
+    return false ;
+}
+
+//-- Pseudo random number in [0, 1) (as minisat) ---------------------------------------------
+double SatSolver::drand( void )
+{
+    this->_randseed *= 1389796 ;
+    int q = (int)( this->_randseed / 2147483647 );
+    this->_randseed -= (double)q * 2147483647 ;
+    return this->_randseed / 2147483647 ;
+}
+
+double SatSolver::luby( double y, int x )
+{
+    int size = 1, seq = 0 ;
+    while( size < x+1 ) { seq++; size = 2*size + 1; }
+    while( size-1 != x )
+    {
+        size = (size-1) >> 1 ;
+        seq-- ;
+        x = x % size ;
+    }
+    return pow( y, seq );
+}
+
+/*------------------------------------------------------------------------------------
+ FuncName:
+    solve
+ Introduction:
+    Solve the current clause set under the given assumptions (DIMACS literals).
+    Return SAT_SAT (model in getModel()) or SAT_UNSAT (failed assumptions in
+    getConflict(); empty if the clause set itself is UNSAT), or SAT_UNKNOWN if
+    interrupt() has been called (the flag stays set until clearInterrupt()) or
+    the budget of setBudget() runs out.
+ -------------------------------------------------------------------------------------*/
+int SatSolver::solve( const vector<int> &assumps )
+{
+    this->_model.clear();
+    this->_conflict.clear();
+    this->_solves++ ;
+    if( !this->_ok ) return SAT_UNSAT ;
+    this->_solveconflicts = this->_conflicts ;
+    this->_solvestart     = chrono::steady_clock::now();
+
+    this->_assumps.clear();
+    for( auto dimacs: assumps )
+    {
+        this->reserveVars( abs(dimacs) );
+        this->_assumps.push_back( toLit(dimacs) );
+    }
+    this->simplify();
+    this->_maxlearnts = max( this->_maxlearnts, this->nClauses() / 3.0 + 100 );
+
+    int status = -1, restarts = 0 ;
+    while( status == -1 )
+    {
+        double rest = ( this->_config._restart == SAT_RESTART_LUBY ) ? luby( this->_config._restartinc, restarts )
+                                                                     : pow( this->_config._restartinc, restarts );
+        status = this->search( (long)min( rest * this->_config._restartfirst, 1e12 ) );
+        restarts++ ;
+        this->_maxlearnts *= 1.02 ;
+    }
+
+    if( status == SAT_SAT )
+    {
+        this->_model.resize( this->nVars() );
+        for( int var = 0; var < this->nVars(); var++ )
+            this->_model[var] = ( this->_assigns[var] == 1 ) ? ( var+1 ) : ( -(var+1) );
+    }
+    this->cancelUntil(0);
+    return status ;
+}
+
+/*------------------------------------------------------------------------------------
+ FuncName:
+    writeResult
+ Introduction:
+    Dump the result as minisat does ("SAT\n<model> 0\n" or "UNSAT\n"),
+    or "UNKNOWN\n" if the call is interrupted
+ -------------------------------------------------------------------------------------*/
+bool SatSolver::writeResult( string filename, int status )
+{
+    fstream outfile ;
+    outfile.open( filename, ios::out | fstream::trunc );
+    if( !outfile.is_open() ) return false ;
+    if( status == SAT_SAT )
+    {
+        outfile << "SAT\n" ;
+        for( auto lit: this->_model ) outfile << lit << " " ;
+        outfile << "0\n" ;
+    }
+    else if( status == SAT_UNKNOWN )
+        outfile << "UNKNOWN\n" ;
+    else
+        outfile << "UNSAT\n" ;
+    outfile.close();
+    return true ;
+}
@@ -0,0 +1,189 @@
+//////////////////////////////////////////////////////////////
+//
+// Header File
+//
+// File name: satsolver.h
+// Introduction:
+//    In-process incremental CDCL SAT solver (MiniSat-style).
+//    Clauses are given as DIMACS literals (+v/-v, v >= 1), so
+//    the clause strings produced by ClockTree can be fed to it
+//    directly without writing/reading CNF files.
+//
+//////////////////////////////////////////////////////////////
+
+#ifndef SATSOLVER_H
+#define SATSOLVER_H
+
+#include <vector>
+#include <string>
+#include <atomic>
+#include <chrono>
+
+// Return value of SatSolver::solve()
+#define SAT_UNSAT       (0)
+#define SAT_SAT         (1)
+#define SAT_UNKNOWN     (2)     // Interrupted or out of budget
+// Restart policy of SAT_CONFIG
+#define SAT_RESTART_LUBY    (0)
+#define SAT_RESTART_GEOM    (1)
+// Initial phase of SAT_CONFIG
+#define SAT_PHASE_NEG       (0)
+#define SAT_PHASE_POS       (1)
+#define SAT_PHASE_RAND      (2)
+
+using namespace std;
+
+/*------------------------------------------------------------------
+ Data Type Name:
+    SAT_CONFIG
+ Introduction:
+    Search configuration of SatSolver (set before the first var)
+ -------------------------------------------------------------------*/
+struct SAT_CONFIG
+{
+    int         _restart        ;//SAT_RESTART_LUBY / SAT_RESTART_GEOM
+    double      _restartfirst   ;//# conflicts of the first restart
+    double      _restartinc     ;//base of luby / factor of geometric
+    double      _seed           ;//0: no randomization
+    double      _randfreq       ;//frequency of random decisions (needs _seed)
+    int         _phase          ;//SAT_PHASE_NEG / SAT_PHASE_POS / SAT_PHASE_RAND
+};
+
+/*------------------------------------------------------------------
+ Data Type Name:
+    SatSolver
+ Introduction:
+    Conflict-driven clause learning solver with two watched literals,
+    VSIDS, phase saving, Luby restarts and learnt clause reduction.
+    It is incremental: clauses can be added between calls of solve()
+    and learnt clauses are kept, so a sequence of growing clause sets
+    (e.g. timing clauses of a decreasing Tc) is solved cheaply.
+    Literal encoding inside the solver: lit = 2*var + sign, var >= 0.
+ -------------------------------------------------------------------*/
+class SatSolver
+{
+private:
+    //-- Clause -------------------------------------------------------------------
+    struct Clause
+    {
+        bool        learnt  ;
+        bool        removed ;
+        float       act     ;
+        vector<int> lits    ;
+    };
+    struct Watcher
+    {
+        Clause *cref    ;
+        int     blocker ;
+        Watcher( Clause *c = nullptr, int b = 0 ) : cref(c), blocker(b) {}
+    };
+
+    //-- Solver state -------------------------------------------------------------
+    bool                        _ok         ;
+    vector< Clause* >           _clauses    ;
+    vector< Clause* >           _learnts    ;
+    vector< vector<Watcher> >   _watches    ;//indexed by literal
+    vector< signed char >       _assigns    ;//0: undef, 1: true, -1: false (per var)
+    vector< char >              _polarity   ;//saved phase, 1 => negative literal
+    vector< Clause* >           _reason     ;
+    vector< int >               _level      ;
+    vector< double >            _activity   ;
+    vector< char >              _seen       ;
+    vector< int >               _trail      ;
+    vector< int >               _traillim   ;
+    vector< int >               _assumps    ;
+    vector< int >               _stack      ;//used by litRedundant
+    vector< int >               _toclear    ;//used by analyze
+    long                        _qhead      ;
+    long                        _simpassigns;//trail size at level 0 of the last simplify()
+    //-- VSIDS heap -----------------------------------------------------------------
+    vector< int >               _heap       ;
+    vector< int >               _heapidx    ;
+    double                      _varinc, _vardecay, _clainc, _cladecay;
+    double                      _maxlearnts ;
+    //-- Result ---------------------------------------------------------------------
+    vector< int >               _model      ;//DIMACS literal of each var
+    vector< int >               _conflict   ;//DIMACS assumption literals in final conflict
+    //-- Statistics -----------------------------------------------------------------
+    long                        _solves, _conflicts, _decisions, _propagations;
+    //-- Interrupt (may be set by another thread) ---------------------------------------
+    atomic< bool >              _interrupt  ;
+    //-- Configuration ------------------------------------------------------------------
+    SAT_CONFIG                  _config     ;
+    double                      _randseed   ;
+    //-- Budget of each solve() ------------------------------------------------------------
+    long                        _conflictbudget ;//-1: no limit
+    double                      _timebudget     ;//seconds, <= 0: no limit
+    long                        _solveconflicts ;//_conflicts at the start of solve()
+    chrono::steady_clock::time_point _solvestart;
+
+    //-- Literal helpers --------------------------------------------------------------
+    static int  toLit( int dimacs )     { return ( dimacs > 0 ) ? ( 2*(dimacs-1) ) : ( 2*(-dimacs-1) + 1 ); }
+    static int  toDimacs( int lit )     { return ( lit & 1 ) ? ( -((lit >> 1)+1) ) : ( (lit >> 1)+1 ); }
+    int         value( int lit )        { signed char v = _assigns[lit >> 1]; return ( lit & 1 ) ? -v : v; }
+    int         decisionLevel( void )   { return (int)_traillim.size(); }
+
+    //-- VSIDS heap --------------------------------------------------------------------
+    bool        heapLess( int a, int b ){ return _activity[a] > _activity[b]; }
+    void        heapUp( int pos );
+    void        heapDown( int pos );
+    void        heapInsert( int var );
+    int         heapPop( void );
+    void        varBump( int var );
+    void        claBump( Clause *c );
+
+    //-- CDCL core ---------------------------------------------------------------------
+    void        attachClause( Clause *c );
+    void        detachAll( void );
+    void        enqueue( int lit, Clause *from );
+    Clause*     propagate( void );
+    void        analyze( Clause *confl, vector<int> &learnt, int &btlevel );
+    bool        litRedundant( int lit, unsigned abstractlevels );
+    void        analyzeFinal( int lit );
+    void        cancelUntil( int level );
+    int         pickBranchLit( void );
+    void        reduceDB( void );
+    void        simplify( void );
+    int         search( long nofconflicts );
+    static double luby( double y, int x );
+    double      drand( void );
+    bool        budgetOut( void );
+
+public:
+    //-Constructor/Destructor---------------------------------------------------------
+    SatSolver( void );
+    ~SatSolver( void );
+
+    //-Setter methods-----------------------------------------------------------------
+    void    setConfig( const SAT_CONFIG &config );
+    void    setBudget( long conflicts, double seconds ) { _conflictbudget = conflicts; _timebudget = seconds; }
+    void    setPhase( const vector<int> &model );  //preferred polarity of each var (DIMACS literals)
+    int     newVar( void );
+    void    reserveVars( int nvars );
+    bool    addClause( const vector<int> &lits );    //DIMACS literals, no trailing 0
+    bool    addClause( const int *lits, long size );
+    bool    addClause( const string &clause );       //"1 -2 3 0"
+
+    //-Solve--------------------------------------------------------------------------
+    int     solve( const vector<int> &assumps = vector<int>() );
+    void    interrupt( void )                   { _interrupt = true         ; }//solve() returns SAT_UNKNOWN
+    void    clearInterrupt( void )              { _interrupt = false        ; }
+
+    //-Getter methods-----------------------------------------------------------------
+    bool    okay( void )                        { return _ok                ; }
+    int     nVars( void )                       { return (int)_assigns.size(); }
+    long    nClauses( void )                    { return (long)_clauses.size(); }
+    long    nLearnts( void )                    { return (long)_learnts.size(); }
+    long    getSolveNumber( void )              { return _solves            ; }
+    long    getConflictNumber( void )           { return _conflicts         ; }
+    long    getDecisionNumber( void )           { return _decisions         ; }
+    long    getPropagationNumber( void )        { return _propagations      ; }
+    const vector<int>&  getModel( void )        { return _model             ; }
+    const vector<int>&  getConflict( void )     { return _conflict          ; }
+
+    //-Dumper-------------------------------------------------------------------------
+    //Write the result in the format of minisat output file
+    bool    writeResult( string filename, int status );
+};
+
+#endif  // SATSOLVER_H
@@ -51,7 +51,7 @@ vector<string> stringSplit(string input, const char *delimiters)
 		return {};                              // Same as "return vector<string>();"
 	
 	vector<string> result;                      // Result list after splitting
-	char inputarray[input.length()], *ptr;      // Copy of input string & pointer of split string
+	char inputarray[input.length()+1], *ptr;    // Copy of input string & pointer of split string
 	
 	strcpy(inputarray, input.c_str());
 	ptr = strtok(inputarray, delimiters);